@@ -0,0 +1,574 @@
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <divtomulti/divtomulti.h>
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+
+namespace bench {
+
+// DivToMultiBench [--width u32|i32|u64|i64|all] [--format csv|json] [--size N] [--reps N]
+struct BenchOptions {
+  std::string width = "all";
+  std::string format = "csv";
+  size_t size = 4096; // dividends per timed pass
+  unsigned reps = 20; // timed passes; the fastest one is reported
+};
+
+struct BenchRecord {
+  std::string width;
+  std::string divisor_class;
+  std::string divisor;
+  std::string method;
+  std::string mode; // throughput: independent dividends, latency: each dividend depends on the last quotient
+  double ns_per_op;
+};
+
+// Hides a constant from the optimizer, so hardware division keeps its div
+// instruction and Divider<T> cannot be folded into ConstDivider<T, D>
+template <typename IntType> IntType opaque(IntType value) {
+  volatile IntType hidden = value;
+  return hidden;
+}
+
+template <typename IntType> volatile IntType sink;
+
+template <typename IntType> void keep(IntType value) {
+  sink<IntType> = value;
+}
+
+template <typename IntType> std::vector<IntType> make_dividends(size_t n) {
+  std::mt19937_64 rng(2024);
+  std::vector<IntType> dividends(n);
+  for (auto &value : dividends) {
+    value = static_cast<IntType>(rng());
+  }
+  return dividends;
+}
+
+template <typename Pass> double best_ns_per_op(size_t n, unsigned reps, Pass pass) {
+  double best = std::numeric_limits<double>::max();
+  for (unsigned r = 0; r < reps; ++r) {
+    auto const start = std::chrono::steady_clock::now();
+    pass();
+    auto const stop = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(n));
+  }
+  return best;
+}
+
+template <typename IntType, typename Op> double throughput(std::vector<IntType> const &in, unsigned reps, Op op) {
+  return best_ns_per_op(in.size(), reps, [&] {
+    IntType sum = 0;
+    for (IntType dividend : in) {
+      sum = static_cast<IntType>(sum + op(dividend));
+    }
+    keep(sum);
+  });
+}
+
+template <typename IntType, typename Op> double latency(std::vector<IntType> const &in, unsigned reps, Op op) {
+  return best_ns_per_op(in.size(), reps, [&] {
+    IntType q = 0;
+    for (IntType dividend : in) {
+      q = op(static_cast<IntType>(dividend ^ (q & 1)));
+    }
+    keep(q);
+  });
+}
+
+char const *tier_name(DispatchTier tier) {
+  switch (tier) {
+  case DispatchTier::Scalar:
+    return "scalar";
+  case DispatchTier::BMI2:
+    return "bmi2";
+  case DispatchTier::SSE41:
+    return "sse41";
+  case DispatchTier::AVX2:
+    return "avx2";
+  case DispatchTier::AVX512:
+    return "avx512";
+  case DispatchTier::NEON:
+    return "neon";
+  }
+  return "unknown";
+}
+
+// One divisor class: hardware division, opt_cal (magic recomputed per call),
+// Divider<T>, ConstDivider<T, D>, a DividerCache<T> hit per call,
+// JitDivider<T>, FloatDivider<T> for 32-bit widths, and the batch kernel of
+// every supported tier
+template <typename IntType, IntType D, typename Normal, typename Opt, typename Batch>
+void bench_class(char const *width, char const *divisor_class, std::vector<IntType> const &in, BenchOptions const &options, Normal normal, Opt opt,
+                 Batch batch, std::vector<BenchRecord> &records) {
+  IntType const divisor = opaque(D);
+  Divider<IntType> const divider(divisor);
+  std::string const divisor_text = std::to_string(D);
+  auto add = [&](std::string const &method, char const *mode, double ns) {
+    records.push_back({width, divisor_class, divisor_text, method, mode, ns});
+  };
+  auto scalar = [&](char const *method, auto op) {
+    add(method, "throughput", throughput(in, options.reps, op));
+    add(method, "latency", latency(in, options.reps, op));
+  };
+
+  scalar("normal_cal", [&](IntType x) { return normal(x, divisor); });
+  scalar("opt_cal", [&](IntType x) { return opt(x, divisor); });
+  scalar("divider", [&](IntType x) { return divider.divide(x); });
+  scalar("const_divider", [](IntType x) { return ConstDivider<IntType, D>::divide(x); });
+  DividerCache<IntType> cache;
+  scalar("cached", [&](IntType x) { return cache.get(divisor).divide(x); });
+  JitDivider<IntType> const jit_divider(divisor);
+  scalar("jit", [&](IntType x) { return jit_divider.divide(x); });
+  if constexpr (sizeof(IntType) == 4) {
+    FloatDivider<IntType> const fp_divider(divisor);
+    scalar("float", [&](IntType x) { return fp_divider.divide(x); });
+  }
+
+  std::vector<IntType> out(in.size());
+  for (DispatchTier tier : {DispatchTier::Scalar, DispatchTier::BMI2, DispatchTier::SSE41, DispatchTier::AVX2, DispatchTier::AVX512, DispatchTier::NEON}) {
+    if (!force_dispatch_tier(tier)) {
+      continue;
+    }
+    double const ns = best_ns_per_op(in.size(), options.reps, [&] {
+      batch(in.data(), out.data(), in.size(), divider);
+      keep(out[in.size() / 2]);
+    });
+    add(std::string("batch_") + tier_name(tier), "throughput", ns);
+  }
+  reset_dispatch_tier();
+  add("batch_jit", "throughput", best_ns_per_op(in.size(), options.reps, [&] {
+        jit_divider.divide(in.data(), out.data(), in.size());
+        keep(out[in.size() / 2]);
+      }));
+  if constexpr (sizeof(IntType) == 4) {
+    FloatDivider<IntType> const fp_divider(divisor);
+    add("batch_float", "throughput", best_ns_per_op(in.size(), options.reps, [&] {
+          dispatch_float_kernels<IntType>().divide_batch(in.data(), out.data(), in.size(), fp_divider);
+          keep(out[in.size() / 2]);
+        }));
+  }
+}
+
+// Magic number generation for divisors that change per call: the Hacker's
+// Delight loop, the single-division generator, and a whole Divider<T>
+template <typename UIntType> void bench_magic(char const *width, BenchOptions const &options, std::vector<BenchRecord> &records) {
+  constexpr unsigned B = sizeof(UIntType) * 8;
+  std::vector<UIntType> divisors = make_dividends<UIntType>(options.size);
+  for (auto &divisor : divisors) {
+    // Every magnitude, not just full-width divisors
+    divisor = static_cast<UIntType>(divisor >> (divisor % B));
+    divisor = divisor < 2 ? 3 : divisor;
+  }
+  auto add = [&](char const *method, double ns) {
+    records.push_back({width, "construct", "random", method, "throughput", ns});
+  };
+  add("get_unsigned_magic", throughput(divisors, options.reps, [](UIntType d) {
+        auto const dm = get_unsigned_magic(d);
+        return static_cast<UIntType>(dm.magic + dm.shift);
+      }));
+  add("get_unsigned_magic_fast", throughput(divisors, options.reps, [](UIntType d) {
+        auto const dm = get_unsigned_magic_fast(d);
+        return static_cast<UIntType>(dm.magic + dm.shift);
+      }));
+  add("divider", throughput(divisors, options.reps, [](UIntType d) { return Divider<UIntType>(d).magic(); }));
+}
+
+// A different divisor per element, drawn from every class the branchy paths
+// special-case: +-1, powers of two, large divisors and magic numbers with and
+// without the add correction. Dividers are built up front, so only the
+// divides are timed.
+template <typename SIntType, typename Normal, typename Opt>
+void bench_mixed(char const *width, BenchOptions const &options, Normal normal, Opt opt, std::vector<BenchRecord> &records) {
+  using UIntType = typename std::make_unsigned<SIntType>::type;
+  constexpr unsigned B = sizeof(SIntType) * 8;
+  std::vector<SIntType> const in = make_dividends<SIntType>(options.size);
+  std::vector<SIntType> divisors(options.size);
+  std::mt19937_64 rng(2025);
+  for (auto &divisor : divisors) {
+    uint64_t const bits = rng();
+    UIntType magnitude;
+    switch (bits % 4) {
+    case 0:
+      magnitude = 1;
+      break;
+    case 1:
+      magnitude = static_cast<UIntType>(UIntType(1) << ((bits >> 8) % (B - 1)));
+      break;
+    case 2:
+      magnitude = static_cast<UIntType>((static_cast<UIntType>(-1) >> 1) - ((bits >> 8) & 0xFFFF));
+      break;
+    default:
+      magnitude = static_cast<UIntType>(static_cast<UIntType>(bits >> 8) >> ((bits >> 2) % (B - 8)));
+      magnitude = magnitude < 3 ? 3 : magnitude;
+      break;
+    }
+    divisor = (bits >> 63) != 0 ? static_cast<SIntType>(0U - magnitude) : static_cast<SIntType>(magnitude);
+  }
+  std::vector<Divider<SIntType>> dividers;
+  std::vector<BranchfreeDivider<SIntType>> branchfree;
+  for (SIntType divisor : divisors) {
+    dividers.emplace_back(divisor);
+    branchfree.emplace_back(divisor);
+  }
+
+  auto add = [&](char const *method, auto op) {
+    double const ns = best_ns_per_op(in.size(), options.reps, [&] {
+      SIntType sum = 0;
+      for (size_t i = 0; i < in.size(); ++i) {
+        sum = static_cast<SIntType>(sum + op(i));
+      }
+      keep(sum);
+    });
+    records.push_back({width, "mixed", "random", method, "throughput", ns});
+  };
+  // MIN / -1 traps in hardware; the guard is predicted not taken
+  add("normal_cal", [&](size_t i) { return in[i] == std::numeric_limits<SIntType>::min() ? SIntType(0) : normal(in[i], divisors[i]); });
+  add("opt_cal", [&](size_t i) { return opt(in[i], divisors[i]); });
+  add("divider", [&](size_t i) { return dividers[i].divide(in[i]); });
+  add("branchfree_divider", [&](size_t i) { return branchfree[i].divide(in[i]); });
+}
+
+// Integer to decimal text: format_decimal against std::to_chars and an
+// std::ostream, each writing the whole array into one buffer
+template <typename IntType> void bench_format(char const *width, BenchOptions const &options, std::vector<BenchRecord> &records) {
+  constexpr unsigned B = sizeof(IntType) * 8;
+  std::vector<IntType> values = make_dividends<IntType>(options.size);
+  for (auto &value : values) {
+    // Every digit count, not just full-width values
+    value = static_cast<IntType>(value >> (static_cast<unsigned>(value) % B));
+  }
+  std::vector<char> text(values.size() * (max_decimal_chars<IntType>() + 1));
+  auto add = [&](char const *method, double ns) {
+    records.push_back({width, "format", "random", method, "throughput", ns});
+  };
+
+  add("format_decimal", best_ns_per_op(values.size(), options.reps, [&] {
+        char *const end = format_decimal(values.data(), values.size(), text.data());
+        keep(end[-2]);
+      }));
+  add("to_chars", best_ns_per_op(values.size(), options.reps, [&] {
+        char *out = text.data();
+        char *const last = text.data() + text.size();
+        for (IntType value : values) {
+          out = std::to_chars(out, last, value).ptr;
+          *out++ = '\n';
+        }
+        keep(out[-2]);
+      }));
+  std::ostringstream stream;
+  add("ostream", best_ns_per_op(values.size(), options.reps, [&] {
+        stream.str(std::string());
+        for (IntType value : values) {
+          stream << value << '\n';
+        }
+        keep(static_cast<char>(stream.tellp()));
+      }));
+}
+
+// Seconds to {seconds, minutes, hours, weekday} plus weeks: the built-in
+// operators chained stage by stage, MixedRadix per value, and its batch form
+template <typename UIntType> void bench_radix(char const *width, BenchOptions const &options, std::vector<BenchRecord> &records) {
+  std::vector<UIntType> const in = make_dividends<UIntType>(options.size);
+  UIntType const shape[] = {opaque<UIntType>(60), opaque<UIntType>(60), opaque<UIntType>(24), opaque<UIntType>(7)};
+  constexpr size_t kStages = sizeof(shape) / sizeof(shape[0]);
+  MixedRadix<UIntType> const radix(shape, kStages);
+  auto add = [&](char const *method, double ns) {
+    records.push_back({width, "radix", "60:60:24:7", method, "throughput", ns});
+  };
+
+  add("normal_cal", throughput(in, options.reps, [&](UIntType x) {
+        UIntType sum = 0;
+        for (UIntType radix_value : shape) {
+          sum = static_cast<UIntType>(sum + x % radix_value);
+          x /= radix_value;
+        }
+        return static_cast<UIntType>(sum + x);
+      }));
+  add("mixed_radix", throughput(in, options.reps, [&](UIntType x) {
+        UIntType digits[kStages];
+        UIntType const high = radix.decompose(x, digits);
+        return static_cast<UIntType>(digits[0] + digits[1] + digits[2] + digits[3] + high);
+      }));
+
+  std::vector<std::vector<UIntType>> digits(kStages, std::vector<UIntType>(in.size()));
+  UIntType *const digit_arrays[] = {digits[0].data(), digits[1].data(), digits[2].data(), digits[3].data()};
+  std::vector<UIntType> high(in.size());
+  add("mixed_radix_batch", best_ns_per_op(in.size(), options.reps, [&] {
+        radix.decompose(in.data(), in.size(), digit_arrays, high.data());
+        keep(high[in.size() / 2]);
+      }));
+}
+
+// (a * b) % m over arrays of residues for an odd, near full-width modulus:
+// the built-in double-width remainder against the Barrett and Montgomery
+// batch forms
+template <typename UIntType> void bench_modular(char const *width, BenchOptions const &options, std::vector<BenchRecord> &records) {
+  using WideType = typename WiderType<UIntType>::type;
+  UIntType const modulus = opaque<UIntType>(static_cast<UIntType>(static_cast<UIntType>(-1) / 3 * 2 + 1));
+  std::vector<UIntType> a = make_dividends<UIntType>(options.size);
+  std::vector<UIntType> b = make_dividends<UIntType>(options.size);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] %= modulus;
+    b[a.size() - 1 - i] %= modulus;
+  }
+  std::vector<UIntType> out(a.size());
+  Barrett<UIntType> const barrett(modulus);
+  Montgomery<UIntType> const montgomery(modulus);
+  auto add = [&](char const *method, double ns) {
+    records.push_back({width, "mulmod", "odd", method, "throughput", ns});
+  };
+
+  add("normal_cal", best_ns_per_op(a.size(), options.reps, [&] {
+        for (size_t i = 0; i < a.size(); ++i) {
+          out[i] = static_cast<UIntType>(static_cast<WideType>(a[i]) * b[i] % modulus);
+        }
+        keep(out[a.size() / 2]);
+      }));
+  add("barrett", best_ns_per_op(a.size(), options.reps, [&] {
+        barrett.mulmod(a.data(), b.data(), out.data(), a.size());
+        keep(out[a.size() / 2]);
+      }));
+  add("montgomery", best_ns_per_op(a.size(), options.reps, [&] {
+        montgomery.mulmod(a.data(), b.data(), out.data(), a.size());
+        keep(out[a.size() / 2]);
+      }));
+}
+
+// A long number divided limb by limb, as in decimal printing (10^19 per step)
+// and sieving by a small prime: __udivti3 per limb against the streamed 2-by-1 steps
+void bench_limbs(BenchOptions const &options, std::vector<BenchRecord> &records) {
+  std::vector<uint64_t> const in = make_dividends<uint64_t>(options.size);
+  std::vector<uint64_t> out(in.size());
+  for (uint64_t const d : {10000000000000000000ULL, 1000003ULL}) {
+    uint64_t const divisor = opaque(d);
+    WideDivider<uint64_t> const divider(divisor);
+    std::string const divisor_text = std::to_string(d);
+    auto add = [&](char const *method, double ns) {
+      records.push_back({"u64", "limbs", divisor_text, method, "throughput", ns});
+    };
+
+    add("normal_cal", best_ns_per_op(in.size(), options.reps, [&] {
+          uint64_t r = 0;
+          for (size_t i = in.size(); i-- > 0;) {
+            uint128 const part = (static_cast<uint128>(r) << 64) | in[i];
+            out[i] = static_cast<uint64_t>(part / divisor);
+            r = static_cast<uint64_t>(part % divisor);
+          }
+          keep(r + out[in.size() / 2]);
+        }));
+    add("divide_limbs", best_ns_per_op(in.size(), options.reps, [&] { keep(divide_limbs(in.data(), out.data(), in.size(), divider) + out[in.size() / 2]); }));
+    add("remainder_limbs", best_ns_per_op(in.size(), options.reps, [&] { keep(remainder_limbs(in.data(), in.size(), divider)); }));
+  }
+}
+
+// base + i * step over a divisor that is not a power of two, e.g. offsets to
+// tiles: a division per term, Divider<T> per term, and DivisionProgression,
+// which only adds
+template <typename UIntType> void bench_progression(char const *width, BenchOptions const &options, std::vector<BenchRecord> &records) {
+  UIntType const base = opaque<UIntType>(12345);
+  UIntType const step = opaque<UIntType>(4099);
+  UIntType const divisor = opaque<UIntType>(3000);
+  Divider<UIntType> const divider(divisor);
+  std::vector<UIntType> out(options.size);
+  auto add = [&](char const *method, double ns) {
+    records.push_back({width, "progression", "3000", method, "throughput", ns});
+  };
+
+  add("normal_cal", best_ns_per_op(out.size(), options.reps, [&] {
+        for (size_t i = 0; i < out.size(); ++i) {
+          out[i] = static_cast<UIntType>(base + i * step) / divisor;
+        }
+        keep(out[out.size() / 2]);
+      }));
+  add("divider", best_ns_per_op(out.size(), options.reps, [&] {
+        for (size_t i = 0; i < out.size(); ++i) {
+          out[i] = divider.divide(static_cast<UIntType>(base + i * step));
+        }
+        keep(out[out.size() / 2]);
+      }));
+  add("progression", best_ns_per_op(out.size(), options.reps, [&] {
+        DivisionProgression<UIntType>(base, step, divisor).divide(out.data(), out.size());
+        keep(out[out.size() / 2]);
+      }));
+}
+
+// Divisor classes, checked against the strategy each one is meant to exercise
+static_assert(ConstDivider<uint32_t, 10>::strategy == DivStrategy::MulShift, "u32 mul class");
+static_assert(ConstDivider<uint32_t, 7>::strategy == DivStrategy::MulAddShift, "u32 add class");
+static_assert(ConstDivider<int32_t, 10>::strategy == DivStrategy::MulShift, "i32 mul class");
+static_assert(ConstDivider<int32_t, 7>::strategy == DivStrategy::MulAddShift, "i32 add class");
+static_assert(ConstDivider<int32_t, (1 << 30) + 1>::strategy == DivStrategy::LargeDivisor, "i32 large class");
+static_assert(ConstDivider<uint64_t, 10>::strategy == DivStrategy::MulShift, "u64 mul class");
+static_assert(ConstDivider<uint64_t, 7>::strategy == DivStrategy::MulAddShift, "u64 add class");
+static_assert(ConstDivider<int64_t, 10>::strategy == DivStrategy::MulShift, "i64 mul class");
+static_assert(ConstDivider<int64_t, 15>::strategy == DivStrategy::MulAddShift, "i64 add class");
+static_assert(ConstDivider<int64_t, (1LL << 62) + 1>::strategy == DivStrategy::LargeDivisor, "i64 large class");
+
+void bench_u32(BenchOptions const &options, std::vector<BenchRecord> &records) {
+  std::vector<uint32_t> const in = make_dividends<uint32_t>(options.size);
+  auto normal = [](uint32_t x, uint32_t d) { return u32div::normal_cal(x, d); };
+  auto opt = [](uint32_t x, uint32_t d) { return u32div::opt_cal(x, d); };
+  auto batch = [](const uint32_t *src, uint32_t *dst, size_t n, Divider<uint32_t> const &divider) { u32div::divide(src, dst, n, divider); };
+  bench_class<uint32_t, 64>("u32", "pow2", in, options, normal, opt, batch, records);
+  bench_class<uint32_t, 10>("u32", "mul", in, options, normal, opt, batch, records);
+  bench_class<uint32_t, 7>("u32", "add", in, options, normal, opt, batch, records);
+  bench_class<uint32_t, (1U << 31) + 1>("u32", "large", in, options, normal, opt, batch, records);
+  bench_magic<uint32_t>("u32", options, records);
+  bench_format<uint32_t>("u32", options, records);
+  bench_radix<uint32_t>("u32", options, records);
+  bench_modular<uint32_t>("u32", options, records);
+  bench_progression<uint32_t>("u32", options, records);
+}
+
+void bench_i32(BenchOptions const &options, std::vector<BenchRecord> &records) {
+  std::vector<int32_t> const in = make_dividends<int32_t>(options.size);
+  auto normal = [](int32_t x, int32_t d) { return i32div::normal_cal(x, d); };
+  auto opt = [](int32_t x, int32_t d) { return i32div::opt_cal_signed(x, d); };
+  auto batch = [](const int32_t *src, int32_t *dst, size_t n, Divider<int32_t> const &divider) { i32div::divide(src, dst, n, divider); };
+  bench_class<int32_t, 64>("i32", "pow2", in, options, normal, opt, batch, records);
+  bench_class<int32_t, 10>("i32", "mul", in, options, normal, opt, batch, records);
+  bench_class<int32_t, 7>("i32", "add", in, options, normal, opt, batch, records);
+  bench_class<int32_t, (1 << 30) + 1>("i32", "large", in, options, normal, opt, batch, records);
+  bench_class<int32_t, -10>("i32", "negative", in, options, normal, opt, batch, records);
+  bench_mixed<int32_t>("i32", options, normal, opt, records);
+  bench_format<int32_t>("i32", options, records);
+}
+
+void bench_u64(BenchOptions const &options, std::vector<BenchRecord> &records) {
+  std::vector<uint64_t> const in = make_dividends<uint64_t>(options.size);
+  auto normal = [](uint64_t x, uint64_t d) { return u64div::normal_cal(x, d); };
+  auto opt = [](uint64_t x, uint64_t d) { return u64div::opt_cal(x, d); };
+  auto batch = [](const uint64_t *src, uint64_t *dst, size_t n, Divider<uint64_t> const &divider) { u64div::divide(src, dst, n, divider); };
+  bench_class<uint64_t, 64>("u64", "pow2", in, options, normal, opt, batch, records);
+  bench_class<uint64_t, 10>("u64", "mul", in, options, normal, opt, batch, records);
+  bench_class<uint64_t, 7>("u64", "add", in, options, normal, opt, batch, records);
+  bench_class<uint64_t, (1ULL << 63) + 1>("u64", "large", in, options, normal, opt, batch, records);
+  bench_magic<uint64_t>("u64", options, records);
+  bench_format<uint64_t>("u64", options, records);
+  bench_radix<uint64_t>("u64", options, records);
+  bench_modular<uint64_t>("u64", options, records);
+  bench_progression<uint64_t>("u64", options, records);
+  bench_limbs(options, records);
+}
+
+void bench_i64(BenchOptions const &options, std::vector<BenchRecord> &records) {
+  std::vector<int64_t> const in = make_dividends<int64_t>(options.size);
+  auto normal = [](int64_t x, int64_t d) { return i64div::normal_cal(x, d); };
+  auto opt = [](int64_t x, int64_t d) { return i64div::opt_cal_signed(x, d); };
+  auto batch = [](const int64_t *src, int64_t *dst, size_t n, Divider<int64_t> const &divider) { i64div::divide(src, dst, n, divider); };
+  bench_class<int64_t, 64>("i64", "pow2", in, options, normal, opt, batch, records);
+  bench_class<int64_t, 10>("i64", "mul", in, options, normal, opt, batch, records);
+  bench_class<int64_t, 15>("i64", "add", in, options, normal, opt, batch, records);
+  bench_class<int64_t, (1LL << 62) + 1>("i64", "large", in, options, normal, opt, batch, records);
+  bench_class<int64_t, -10>("i64", "negative", in, options, normal, opt, batch, records);
+  bench_mixed<int64_t>("i64", options, normal, opt, records);
+  bench_format<int64_t>("i64", options, records);
+}
+
+void write_csv(std::ostream &out, std::vector<BenchRecord> const &records) {
+  out << "width,class,divisor,method,mode,ns_per_op\n";
+  for (auto const &r : records) {
+    out << r.width << ',' << r.divisor_class << ',' << r.divisor << ',' << r.method << ',' << r.mode << ',' << r.ns_per_op << '\n';
+  }
+}
+
+// The default tier and CPU features go into the JSON header, so results from
+// different machines can be told apart
+void write_json(std::ostream &out, std::vector<BenchRecord> const &records) {
+  CpuFeatures const &features = cpu_features();
+  out << std::boolalpha << "{\n  \"tier\": \"" << tier_name(dispatch().tier) << "\",\n";
+  out << "  \"features\": {\"sse41\": " << features.sse41 << ", \"avx2\": " << features.avx2 << ", \"bmi2\": " << features.bmi2
+      << ", \"avx512f\": " << features.avx512f << ", \"avx512dq\": " << features.avx512dq << ", \"avx512ifma\": " << features.avx512ifma
+      << ", \"neon\": " << features.neon << "},\n";
+  out << "  \"results\": [\n";
+  for (size_t i = 0; i < records.size(); ++i) {
+    auto const &r = records[i];
+    // Construction benchmarks run over many divisors and name them instead
+    bool const numeric = r.divisor.find_first_not_of("-0123456789") == std::string::npos;
+    std::string const divisor = numeric ? r.divisor : '"' + r.divisor + '"';
+    out << "    {\"width\": \"" << r.width << "\", \"class\": \"" << r.divisor_class << "\", \"divisor\": " << divisor << ", \"method\": \""
+        << r.method << "\", \"mode\": \"" << r.mode << "\", \"ns_per_op\": " << r.ns_per_op << '}' << (i + 1 < records.size() ? "," : "") << '\n';
+  }
+  out << "  ]\n}\n";
+}
+
+std::vector<BenchRecord> run(BenchOptions const &options) {
+  std::vector<BenchRecord> records;
+  bool const all = options.width == "all";
+  if (all || options.width == "u32") {
+    bench_u32(options, records);
+  }
+  if (all || options.width == "i32") {
+    bench_i32(options, records);
+  }
+  if (all || options.width == "u64") {
+    bench_u64(options, records);
+  }
+  if (all || options.width == "i64") {
+    bench_i64(options, records);
+  }
+  return records;
+}
+
+int run_cli(int argc, char **argv) {
+  BenchOptions options;
+  for (int i = 0; i < argc; ++i) {
+    std::string const flag = argv[i];
+    if (i + 1 == argc) {
+      std::cout << "Error: missing value for " << flag << std::endl;
+      return 2;
+    }
+    std::string const value = argv[++i];
+    if (flag == "--width") {
+      options.width = value;
+    } else if (flag == "--format") {
+      options.format = value;
+    } else if (flag == "--size") {
+      options.size = static_cast<size_t>(std::strtoull(value.c_str(), nullptr, 0));
+    } else if (flag == "--reps") {
+      options.reps = static_cast<unsigned>(std::strtoul(value.c_str(), nullptr, 0));
+    } else {
+      std::cout << "Usage: DivToMultiBench [--width u32|i32|u64|i64|all] [--format csv|json] [--size N] [--reps N]" << std::endl;
+      return 2;
+    }
+  }
+  if (options.width != "all" && options.width != "u32" && options.width != "i32" && options.width != "u64" && options.width != "i64") {
+    std::cout << "Error: unknown width " << options.width << std::endl;
+    return 2;
+  }
+  if (options.format != "csv" && options.format != "json") {
+    std::cout << "Error: unknown format " << options.format << std::endl;
+    return 2;
+  }
+  if (options.size == 0 || options.reps == 0) {
+    std::cout << "Error: --size and --reps must be positive" << std::endl;
+    return 2;
+  }
+
+  std::vector<BenchRecord> const records = run(options);
+  if (options.format == "json") {
+    write_json(std::cout, records);
+  } else {
+    write_csv(std::cout, records);
+  }
+  return 0;
+}
+
+} // namespace bench
+
+int main(int argc, char **argv) {
+  return bench::run_cli(argc - 1, argv + 1);
+}
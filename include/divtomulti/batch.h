@@ -0,0 +1,858 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "divider.h"
+#include "intrinsics.h"
+
+// =============================================================================
+// Batch division kernels
+// =============================================================================
+
+// Vectorized form of the Divider<T> hot path over arrays. Each ISA namespace
+// handles whole vectors and leaves the tail to the scalar kernel, so every
+// tier produces bit-identical results. Remainders are computed per block:
+// quotients first, then in - divisor * quotient while the block is in L1.
+// divmod() keeps the quotients of each block instead of overwriting them.
+
+constexpr size_t kRemainderBlock = 256;
+
+namespace batch {
+
+namespace scalar {
+
+template <typename IntType> IntType divide(IntType dividend, Divider<IntType> const &divider) {
+  return divider.divide(dividend);
+}
+
+template <typename IntType> void divide(const IntType *in, IntType *out, size_t n, Divider<IntType> const &divider) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = divider.divide(in[i]);
+  }
+}
+
+template <typename IntType> void remainder(const IntType *in, IntType *out, size_t n, Divider<IntType> const &divider) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = divider.remainder(in[i]);
+  }
+}
+
+template <typename IntType> void divmod(const IntType *in, IntType *quotient, IntType *remainder, size_t n, Divider<IntType> const &divider) {
+  for (size_t i = 0; i < n; ++i) {
+    DivMod<IntType> const qr = divider.divmod(in[i]);
+    quotient[i] = qr.quotient;
+    remainder[i] = qr.remainder;
+  }
+}
+
+// out[i] = in[i] - divisor * quotient[i], wrapping like the scalar remainder.
+// out may be quotient itself, as in remainder().
+template <typename IntType> void multiply_subtract(const IntType *in, const IntType *quotient, IntType *out, size_t n, IntType divisor) {
+  using UIntType = typename std::make_unsigned<IntType>::type;
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = static_cast<IntType>(static_cast<UIntType>(in[i]) - static_cast<UIntType>(divisor) * static_cast<UIntType>(quotient[i]));
+  }
+}
+
+} // namespace scalar
+
+// The blocked remainder and divmod are shared by every vector namespace, which
+// only supplies its quotient kernel and the multiply-subtract kernels it can
+// vectorize. Signed widths run the unsigned kernel on the same bits, which
+// wraps the same way; a width without one (nullptr) falls back to scalar.
+template <typename IntType> using DivideKernel = void (*)(const IntType *in, IntType *out, size_t n, Divider<IntType> const &divider);
+template <typename UIntType>
+using MultiplySubtractKernel = void (*)(const UIntType *in, const UIntType *quotient, UIntType *out, size_t n, UIntType divisor);
+
+template <typename IntType, MultiplySubtractKernel<uint32_t> MultiplySubtract32, MultiplySubtractKernel<uint64_t> MultiplySubtract64>
+void multiply_subtract(const IntType *in, const IntType *quotient, IntType *out, size_t n, IntType divisor) {
+  if constexpr (sizeof(IntType) == 4 && MultiplySubtract32 != nullptr) {
+    MultiplySubtract32(reinterpret_cast<const uint32_t *>(in), reinterpret_cast<const uint32_t *>(quotient), reinterpret_cast<uint32_t *>(out), n,
+                       static_cast<uint32_t>(divisor));
+  } else if constexpr (sizeof(IntType) == 8 && MultiplySubtract64 != nullptr) {
+    MultiplySubtract64(reinterpret_cast<const uint64_t *>(in), reinterpret_cast<const uint64_t *>(quotient), reinterpret_cast<uint64_t *>(out), n,
+                       static_cast<uint64_t>(divisor));
+  } else {
+    scalar::multiply_subtract(in, quotient, out, n, divisor);
+  }
+}
+
+template <typename IntType, DivideKernel<IntType> Divide, MultiplySubtractKernel<uint32_t> MultiplySubtract32,
+          MultiplySubtractKernel<uint64_t> MultiplySubtract64>
+void blocked_remainder(const IntType *in, IntType *out, size_t n, Divider<IntType> const &divider) {
+  for (size_t i = 0; i < n; i += kRemainderBlock) {
+    size_t const block = std::min(kRemainderBlock, n - i);
+    Divide(in + i, out + i, block, divider);
+    multiply_subtract<IntType, MultiplySubtract32, MultiplySubtract64>(in + i, out + i, out + i, block, divider.divisor());
+  }
+}
+
+template <typename IntType, DivideKernel<IntType> Divide, MultiplySubtractKernel<uint32_t> MultiplySubtract32,
+          MultiplySubtractKernel<uint64_t> MultiplySubtract64>
+void blocked_divmod(const IntType *in, IntType *quotient, IntType *remainder, size_t n, Divider<IntType> const &divider) {
+  for (size_t i = 0; i < n; i += kRemainderBlock) {
+    size_t const block = std::min(kRemainderBlock, n - i);
+    Divide(in + i, quotient + i, block, divider);
+    multiply_subtract<IntType, MultiplySubtract32, MultiplySubtract64>(in + i, quotient + i, remainder + i, block, divider.divisor());
+  }
+}
+
+#ifdef DIVTOMULTI_X86
+
+// Same scalar code, compiled so the 64x64->128 multiply-high becomes mulx
+namespace bmi2 {
+
+template <typename IntType> DIVTOMULTI_TARGET("bmi2") IntType divide(IntType dividend, Divider<IntType> const &divider) {
+  return divider.divide(dividend);
+}
+
+template <typename IntType> DIVTOMULTI_TARGET("bmi2") void divide(const IntType *in, IntType *out, size_t n, Divider<IntType> const &divider) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = divider.divide(in[i]);
+  }
+}
+
+template <typename IntType> DIVTOMULTI_TARGET("bmi2") void remainder(const IntType *in, IntType *out, size_t n, Divider<IntType> const &divider) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = divider.remainder(in[i]);
+  }
+}
+
+template <typename IntType>
+DIVTOMULTI_TARGET("bmi2") void divmod(const IntType *in, IntType *quotient, IntType *remainder, size_t n, Divider<IntType> const &divider) {
+  for (size_t i = 0; i < n; ++i) {
+    DivMod<IntType> const qr = divider.divmod(in[i]);
+    quotient[i] = qr.quotient;
+    remainder[i] = qr.remainder;
+  }
+}
+
+} // namespace bmi2
+
+namespace sse41 {
+
+inline DIVTOMULTI_TARGET("sse4.1") __m128i mulhi_epu32(__m128i a, __m128i magic) {
+  __m128i const even = _mm_srli_epi64(_mm_mul_epu32(a, magic), 32);
+  __m128i const odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), magic);
+  return _mm_blend_epi16(even, odd, 0xCC);
+}
+
+inline DIVTOMULTI_TARGET("sse4.1") __m128i mulhi_epi32(__m128i a, __m128i magic) {
+  __m128i const even = _mm_srli_epi64(_mm_mul_epi32(a, magic), 32);
+  __m128i const odd = _mm_mul_epi32(_mm_srli_epi64(a, 32), magic);
+  return _mm_blend_epi16(even, odd, 0xCC);
+}
+
+inline DIVTOMULTI_TARGET("sse4.1") void divide(const uint32_t *in, uint32_t *out, size_t n, Divider<uint32_t> const &divider) {
+  __m128i const magic = _mm_set1_epi32(static_cast<int>(divider.magic()));
+  __m128i const divisor = _mm_set1_epi32(static_cast<int>(divider.divisor()));
+  __m128i const shift = _mm_cvtsi32_si128(static_cast<int>(divider.shift()));
+
+  size_t i = 0;
+  switch (divider.strategy()) {
+  case DivStrategy::MulShift:
+    for (; i + 4 <= n; i += 4) {
+      __m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_srl_epi32(mulhi_epu32(x, magic), shift));
+    }
+    break;
+  case DivStrategy::MulAddShift:
+    for (; i + 4 <= n; i += 4) {
+      __m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i));
+      __m128i const high = mulhi_epu32(x, magic);
+      __m128i const t = _mm_add_epi32(high, _mm_srli_epi32(_mm_sub_epi32(x, high), 1));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_srl_epi32(t, shift));
+    }
+    break;
+  case DivStrategy::Pow2Shift:
+    for (; i + 4 <= n; i += 4) {
+      __m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_srl_epi32(x, shift));
+    }
+    break;
+  case DivStrategy::LargeDivisor:
+    for (; i + 4 <= n; i += 4) {
+      __m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i));
+      __m128i const ge = _mm_cmpeq_epi32(_mm_max_epu32(x, divisor), x);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_srli_epi32(ge, 31));
+    }
+    break;
+  }
+  scalar::divide(in + i, out + i, n - i, divider);
+}
+
+inline DIVTOMULTI_TARGET("sse4.1") void divide(const int32_t *in, int32_t *out, size_t n, Divider<int32_t> const &divider) {
+  int32_t const d = divider.divisor();
+  __m128i const magic = _mm_set1_epi32(divider.magic());
+  __m128i const divisor = _mm_set1_epi32(d);
+  __m128i const sign = _mm_set1_epi32(d < 0 ? -1 : 0);
+  __m128i const abs_divisor = _mm_set1_epi32(static_cast<int>(d < 0 ? 0U - static_cast<uint32_t>(d) : static_cast<uint32_t>(d)));
+  __m128i const shift = _mm_cvtsi32_si128(static_cast<int>(divider.shift()));
+
+  size_t i = 0;
+  switch (divider.strategy()) {
+  case DivStrategy::MulShift:
+  case DivStrategy::MulAddShift: {
+    bool const add = divider.strategy() == DivStrategy::MulAddShift;
+    for (; i + 4 <= n; i += 4) {
+      __m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i));
+      __m128i q = mulhi_epi32(x, magic);
+      if (add) {
+        q = _mm_add_epi32(q, _mm_sub_epi32(_mm_xor_si128(x, sign), sign));
+      }
+      q = _mm_sra_epi32(q, shift);
+      q = _mm_add_epi32(q, _mm_srli_epi32(q, 31));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), q);
+    }
+    break;
+  }
+  case DivStrategy::Pow2Shift: {
+    __m128i const mask = _mm_sub_epi32(abs_divisor, _mm_set1_epi32(1));
+    for (; i + 4 <= n; i += 4) {
+      __m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i));
+      __m128i const sign_correction = _mm_and_si128(_mm_srai_epi32(x, 31), mask);
+      __m128i const q = _mm_sra_epi32(_mm_add_epi32(x, sign_correction), shift);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_sub_epi32(_mm_xor_si128(q, sign), sign));
+    }
+    break;
+  }
+  case DivStrategy::LargeDivisor:
+    for (; i + 4 <= n; i += 4) {
+      __m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i));
+      __m128i const abs_x = _mm_abs_epi32(x);
+      __m128i const q = _mm_srli_epi32(_mm_cmpeq_epi32(_mm_max_epu32(abs_x, abs_divisor), abs_x), 31);
+      __m128i const q_sign = _mm_srai_epi32(_mm_xor_si128(x, divisor), 31);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_sub_epi32(_mm_xor_si128(q, q_sign), q_sign));
+    }
+    break;
+  }
+  scalar::divide(in + i, out + i, n - i, divider);
+}
+
+// Two 64-bit lanes cannot beat the scalar 64x64 multiply-high, so 64-bit stays scalar at this level
+inline void divide(const uint64_t *in, uint64_t *out, size_t n, Divider<uint64_t> const &divider) {
+  scalar::divide(in, out, n, divider);
+}
+
+inline void divide(const int64_t *in, int64_t *out, size_t n, Divider<int64_t> const &divider) {
+  scalar::divide(in, out, n, divider);
+}
+
+inline DIVTOMULTI_TARGET("sse4.1") void multiply_subtract(const uint32_t *in, const uint32_t *quotient, uint32_t *out, size_t n, uint32_t divisor) {
+  __m128i const d = _mm_set1_epi32(static_cast<int>(divisor));
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i));
+    __m128i const q = _mm_loadu_si128(reinterpret_cast<__m128i const *>(quotient + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_sub_epi32(x, _mm_mullo_epi32(q, d)));
+  }
+  scalar::multiply_subtract(in + i, quotient + i, out + i, n - i, divisor);
+}
+
+} // namespace sse41
+
+namespace avx2 {
+
+inline DIVTOMULTI_TARGET("avx2") __m256i mulhi_epu32(__m256i a, __m256i magic) {
+  __m256i const even = _mm256_srli_epi64(_mm256_mul_epu32(a, magic), 32);
+  __m256i const odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), magic);
+  return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+inline DIVTOMULTI_TARGET("avx2") __m256i mulhi_epi32(__m256i a, __m256i magic) {
+  __m256i const even = _mm256_srli_epi64(_mm256_mul_epi32(a, magic), 32);
+  __m256i const odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), magic);
+  return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+// There is no 64x64 multiply-high instruction: build it from four 32x32->64 products
+inline DIVTOMULTI_TARGET("avx2") __m256i mulhi_epu64(__m256i a, __m256i magic_lo, __m256i magic_hi) {
+  __m256i const a_hi = _mm256_srli_epi64(a, 32);
+  __m256i const lo_lo = _mm256_mul_epu32(a, magic_lo);
+  __m256i const hi_lo = _mm256_mul_epu32(a_hi, magic_lo);
+  __m256i const lo_hi = _mm256_mul_epu32(a, magic_hi);
+  __m256i const hi_hi = _mm256_mul_epu32(a_hi, magic_hi);
+  __m256i const t = _mm256_add_epi64(hi_lo, _mm256_srli_epi64(lo_lo, 32));
+  __m256i const w = _mm256_add_epi64(_mm256_and_si256(t, _mm256_set1_epi64x(0xFFFFFFFF)), lo_hi);
+  return _mm256_add_epi64(_mm256_add_epi64(hi_hi, _mm256_srli_epi64(t, 32)), _mm256_srli_epi64(w, 32));
+}
+
+// Arithmetic 64-bit shift right, which AVX2 lacks
+inline DIVTOMULTI_TARGET("avx2") __m256i sra_epi64(__m256i x, __m128i shift) {
+  __m256i const sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), x);
+  return _mm256_xor_si256(_mm256_srl_epi64(_mm256_xor_si256(x, sign), shift), sign);
+}
+
+inline DIVTOMULTI_TARGET("avx2") void divide(const uint32_t *in, uint32_t *out, size_t n, Divider<uint32_t> const &divider) {
+  __m256i const magic = _mm256_set1_epi32(static_cast<int>(divider.magic()));
+  __m256i const divisor = _mm256_set1_epi32(static_cast<int>(divider.divisor()));
+  __m128i const shift = _mm_cvtsi32_si128(static_cast<int>(divider.shift()));
+
+  size_t i = 0;
+  switch (divider.strategy()) {
+  case DivStrategy::MulShift:
+    for (; i + 8 <= n; i += 8) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_srl_epi32(mulhi_epu32(x, magic), shift));
+    }
+    break;
+  case DivStrategy::MulAddShift:
+    for (; i + 8 <= n; i += 8) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      __m256i const high = mulhi_epu32(x, magic);
+      __m256i const t = _mm256_add_epi32(high, _mm256_srli_epi32(_mm256_sub_epi32(x, high), 1));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_srl_epi32(t, shift));
+    }
+    break;
+  case DivStrategy::Pow2Shift:
+    for (; i + 8 <= n; i += 8) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_srl_epi32(x, shift));
+    }
+    break;
+  case DivStrategy::LargeDivisor:
+    for (; i + 8 <= n; i += 8) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      __m256i const ge = _mm256_cmpeq_epi32(_mm256_max_epu32(x, divisor), x);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_srli_epi32(ge, 31));
+    }
+    break;
+  }
+  scalar::divide(in + i, out + i, n - i, divider);
+}
+
+inline DIVTOMULTI_TARGET("avx2") void divide(const int32_t *in, int32_t *out, size_t n, Divider<int32_t> const &divider) {
+  int32_t const d = divider.divisor();
+  __m256i const magic = _mm256_set1_epi32(divider.magic());
+  __m256i const divisor = _mm256_set1_epi32(d);
+  __m256i const sign = _mm256_set1_epi32(d < 0 ? -1 : 0);
+  __m256i const abs_divisor = _mm256_set1_epi32(static_cast<int>(d < 0 ? 0U - static_cast<uint32_t>(d) : static_cast<uint32_t>(d)));
+  __m128i const shift = _mm_cvtsi32_si128(static_cast<int>(divider.shift()));
+
+  size_t i = 0;
+  switch (divider.strategy()) {
+  case DivStrategy::MulShift:
+  case DivStrategy::MulAddShift: {
+    bool const add = divider.strategy() == DivStrategy::MulAddShift;
+    for (; i + 8 <= n; i += 8) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      __m256i q = mulhi_epi32(x, magic);
+      if (add) {
+        q = _mm256_add_epi32(q, _mm256_sub_epi32(_mm256_xor_si256(x, sign), sign));
+      }
+      q = _mm256_sra_epi32(q, shift);
+      q = _mm256_add_epi32(q, _mm256_srli_epi32(q, 31));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), q);
+    }
+    break;
+  }
+  case DivStrategy::Pow2Shift: {
+    __m256i const mask = _mm256_sub_epi32(abs_divisor, _mm256_set1_epi32(1));
+    for (; i + 8 <= n; i += 8) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      __m256i const sign_correction = _mm256_and_si256(_mm256_srai_epi32(x, 31), mask);
+      __m256i const q = _mm256_sra_epi32(_mm256_add_epi32(x, sign_correction), shift);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_sub_epi32(_mm256_xor_si256(q, sign), sign));
+    }
+    break;
+  }
+  case DivStrategy::LargeDivisor:
+    for (; i + 8 <= n; i += 8) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      __m256i const abs_x = _mm256_abs_epi32(x);
+      __m256i const q = _mm256_srli_epi32(_mm256_cmpeq_epi32(_mm256_max_epu32(abs_x, abs_divisor), abs_x), 31);
+      __m256i const q_sign = _mm256_srai_epi32(_mm256_xor_si256(x, divisor), 31);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_sub_epi32(_mm256_xor_si256(q, q_sign), q_sign));
+    }
+    break;
+  }
+  scalar::divide(in + i, out + i, n - i, divider);
+}
+
+inline DIVTOMULTI_TARGET("avx2") void divide(const uint64_t *in, uint64_t *out, size_t n, Divider<uint64_t> const &divider) {
+  __m256i const magic_lo = _mm256_set1_epi64x(static_cast<long long>(divider.magic()));
+  __m256i const magic_hi = _mm256_set1_epi64x(static_cast<long long>(divider.magic() >> 32));
+  __m256i const bias = _mm256_set1_epi64x(INT64_MIN);
+  __m256i const biased_divisor = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(divider.divisor())), bias);
+  __m128i const shift = _mm_cvtsi32_si128(static_cast<int>(divider.shift()));
+
+  size_t i = 0;
+  switch (divider.strategy()) {
+  case DivStrategy::MulShift:
+    for (; i + 4 <= n; i += 4) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_srl_epi64(mulhi_epu64(x, magic_lo, magic_hi), shift));
+    }
+    break;
+  case DivStrategy::MulAddShift:
+    for (; i + 4 <= n; i += 4) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      __m256i const high = mulhi_epu64(x, magic_lo, magic_hi);
+      __m256i const t = _mm256_add_epi64(high, _mm256_srli_epi64(_mm256_sub_epi64(x, high), 1));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_srl_epi64(t, shift));
+    }
+    break;
+  case DivStrategy::Pow2Shift:
+    for (; i + 4 <= n; i += 4) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_srl_epi64(x, shift));
+    }
+    break;
+  case DivStrategy::LargeDivisor: {
+    // Unsigned compare through the signed one: 1 + (divisor > x ? -1 : 0)
+    __m256i const one = _mm256_set1_epi64x(1);
+    for (; i + 4 <= n; i += 4) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      __m256i const lt = _mm256_cmpgt_epi64(biased_divisor, _mm256_xor_si256(x, bias));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_add_epi64(one, lt));
+    }
+    break;
+  }
+  }
+  scalar::divide(in + i, out + i, n - i, divider);
+}
+
+inline DIVTOMULTI_TARGET("avx2") void divide(const int64_t *in, int64_t *out, size_t n, Divider<int64_t> const &divider) {
+  int64_t const d = divider.divisor();
+  int64_t const m = divider.magic();
+  uint64_t const abs_d = d < 0 ? 0U - static_cast<uint64_t>(d) : static_cast<uint64_t>(d);
+  __m256i const zero = _mm256_setzero_si256();
+  __m256i const magic = _mm256_set1_epi64x(m);
+  __m256i const magic_lo = magic;
+  __m256i const magic_hi = _mm256_set1_epi64x(static_cast<long long>(static_cast<uint64_t>(m) >> 32));
+  __m256i const divisor = _mm256_set1_epi64x(d);
+  __m256i const sign = _mm256_set1_epi64x(d < 0 ? -1 : 0);
+  __m256i const abs_divisor = _mm256_set1_epi64x(static_cast<long long>(abs_d));
+  __m128i const shift = _mm_cvtsi32_si128(static_cast<int>(divider.shift()));
+
+  size_t i = 0;
+  switch (divider.strategy()) {
+  case DivStrategy::MulShift:
+  case DivStrategy::MulAddShift: {
+    bool const add = divider.strategy() == DivStrategy::MulAddShift;
+    for (; i + 4 <= n; i += 4) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      // smulh(x, m) = umulh(x, m) - (x < 0 ? m : 0) - (m < 0 ? x : 0)
+      __m256i q = mulhi_epu64(x, magic_lo, magic_hi);
+      q = _mm256_sub_epi64(q, _mm256_and_si256(_mm256_cmpgt_epi64(zero, x), magic));
+      if (m < 0) {
+        q = _mm256_sub_epi64(q, x);
+      }
+      if (add) {
+        q = _mm256_add_epi64(q, _mm256_sub_epi64(_mm256_xor_si256(x, sign), sign));
+      }
+      q = sra_epi64(q, shift);
+      q = _mm256_add_epi64(q, _mm256_srli_epi64(q, 63));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), q);
+    }
+    break;
+  }
+  case DivStrategy::Pow2Shift: {
+    __m256i const mask = _mm256_set1_epi64x(static_cast<long long>(abs_d - 1));
+    for (; i + 4 <= n; i += 4) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      __m256i const sign_correction = _mm256_and_si256(_mm256_cmpgt_epi64(zero, x), mask);
+      __m256i const q = sra_epi64(_mm256_add_epi64(x, sign_correction), shift);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_sub_epi64(_mm256_xor_si256(q, sign), sign));
+    }
+    break;
+  }
+  case DivStrategy::LargeDivisor: {
+    __m256i const one = _mm256_set1_epi64x(1);
+    __m256i const bias = _mm256_set1_epi64x(INT64_MIN);
+    __m256i const biased_abs_divisor = _mm256_xor_si256(abs_divisor, bias);
+    for (; i + 4 <= n; i += 4) {
+      __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+      __m256i const x_sign = _mm256_cmpgt_epi64(zero, x);
+      __m256i const abs_x = _mm256_sub_epi64(_mm256_xor_si256(x, x_sign), x_sign);
+      __m256i const q = _mm256_add_epi64(one, _mm256_cmpgt_epi64(biased_abs_divisor, _mm256_xor_si256(abs_x, bias)));
+      __m256i const q_sign = _mm256_cmpgt_epi64(zero, _mm256_xor_si256(x, divisor));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_sub_epi64(_mm256_xor_si256(q, q_sign), q_sign));
+    }
+    break;
+  }
+  }
+  scalar::divide(in + i, out + i, n - i, divider);
+}
+
+inline DIVTOMULTI_TARGET("avx2") void multiply_subtract(const uint32_t *in, const uint32_t *quotient, uint32_t *out, size_t n, uint32_t divisor) {
+  __m256i const d = _mm256_set1_epi32(static_cast<int>(divisor));
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i));
+    __m256i const q = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(quotient + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_sub_epi32(x, _mm256_mullo_epi32(q, d)));
+  }
+  scalar::multiply_subtract(in + i, quotient + i, out + i, n - i, divisor);
+}
+
+} // namespace avx2
+
+namespace avx512 {
+
+inline DIVTOMULTI_TARGET("avx512f") __m512i mulhi_epu32(__m512i a, __m512i magic) {
+  __m512i const even = _mm512_srli_epi64(_mm512_mul_epu32(a, magic), 32);
+  __m512i const odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), magic);
+  return _mm512_mask_blend_epi32(0xAAAA, even, odd);
+}
+
+inline DIVTOMULTI_TARGET("avx512f") __m512i mulhi_epi32(__m512i a, __m512i magic) {
+  __m512i const even = _mm512_srli_epi64(_mm512_mul_epi32(a, magic), 32);
+  __m512i const odd = _mm512_mul_epi32(_mm512_srli_epi64(a, 32), magic);
+  return _mm512_mask_blend_epi32(0xAAAA, even, odd);
+}
+
+inline DIVTOMULTI_TARGET("avx512f") __m512i mulhi_epu64(__m512i a, __m512i magic_lo, __m512i magic_hi) {
+  __m512i const a_hi = _mm512_srli_epi64(a, 32);
+  __m512i const lo_lo = _mm512_mul_epu32(a, magic_lo);
+  __m512i const hi_lo = _mm512_mul_epu32(a_hi, magic_lo);
+  __m512i const lo_hi = _mm512_mul_epu32(a, magic_hi);
+  __m512i const hi_hi = _mm512_mul_epu32(a_hi, magic_hi);
+  __m512i const t = _mm512_add_epi64(hi_lo, _mm512_srli_epi64(lo_lo, 32));
+  __m512i const w = _mm512_add_epi64(_mm512_and_si512(t, _mm512_set1_epi64(0xFFFFFFFF)), lo_hi);
+  return _mm512_add_epi64(_mm512_add_epi64(hi_hi, _mm512_srli_epi64(t, 32)), _mm512_srli_epi64(w, 32));
+}
+
+inline DIVTOMULTI_TARGET("avx512f") void divide(const uint32_t *in, uint32_t *out, size_t n, Divider<uint32_t> const &divider) {
+  __m512i const magic = _mm512_set1_epi32(static_cast<int>(divider.magic()));
+  __m512i const divisor = _mm512_set1_epi32(static_cast<int>(divider.divisor()));
+  __m128i const shift = _mm_cvtsi32_si128(static_cast<int>(divider.shift()));
+
+  size_t i = 0;
+  switch (divider.strategy()) {
+  case DivStrategy::MulShift:
+    for (; i + 16 <= n; i += 16) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      _mm512_storeu_si512(out + i, _mm512_srl_epi32(mulhi_epu32(x, magic), shift));
+    }
+    break;
+  case DivStrategy::MulAddShift:
+    for (; i + 16 <= n; i += 16) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      __m512i const high = mulhi_epu32(x, magic);
+      __m512i const t = _mm512_add_epi32(high, _mm512_srli_epi32(_mm512_sub_epi32(x, high), 1));
+      _mm512_storeu_si512(out + i, _mm512_srl_epi32(t, shift));
+    }
+    break;
+  case DivStrategy::Pow2Shift:
+    for (; i + 16 <= n; i += 16) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      _mm512_storeu_si512(out + i, _mm512_srl_epi32(x, shift));
+    }
+    break;
+  case DivStrategy::LargeDivisor: {
+    __m512i const one = _mm512_set1_epi32(1);
+    for (; i + 16 <= n; i += 16) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      _mm512_storeu_si512(out + i, _mm512_maskz_mov_epi32(_mm512_cmpge_epu32_mask(x, divisor), one));
+    }
+    break;
+  }
+  }
+  scalar::divide(in + i, out + i, n - i, divider);
+}
+
+inline DIVTOMULTI_TARGET("avx512f") void divide(const int32_t *in, int32_t *out, size_t n, Divider<int32_t> const &divider) {
+  int32_t const d = divider.divisor();
+  __m512i const magic = _mm512_set1_epi32(divider.magic());
+  __m512i const divisor = _mm512_set1_epi32(d);
+  __m512i const sign = _mm512_set1_epi32(d < 0 ? -1 : 0);
+  __m512i const abs_divisor = _mm512_set1_epi32(static_cast<int>(d < 0 ? 0U - static_cast<uint32_t>(d) : static_cast<uint32_t>(d)));
+  __m128i const shift = _mm_cvtsi32_si128(static_cast<int>(divider.shift()));
+
+  size_t i = 0;
+  switch (divider.strategy()) {
+  case DivStrategy::MulShift:
+  case DivStrategy::MulAddShift: {
+    bool const add = divider.strategy() == DivStrategy::MulAddShift;
+    for (; i + 16 <= n; i += 16) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      __m512i q = mulhi_epi32(x, magic);
+      if (add) {
+        q = _mm512_add_epi32(q, _mm512_sub_epi32(_mm512_xor_si512(x, sign), sign));
+      }
+      q = _mm512_sra_epi32(q, shift);
+      q = _mm512_add_epi32(q, _mm512_srli_epi32(q, 31));
+      _mm512_storeu_si512(out + i, q);
+    }
+    break;
+  }
+  case DivStrategy::Pow2Shift: {
+    __m512i const mask = _mm512_sub_epi32(abs_divisor, _mm512_set1_epi32(1));
+    for (; i + 16 <= n; i += 16) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      __m512i const sign_correction = _mm512_and_si512(_mm512_srai_epi32(x, 31), mask);
+      __m512i const q = _mm512_sra_epi32(_mm512_add_epi32(x, sign_correction), shift);
+      _mm512_storeu_si512(out + i, _mm512_sub_epi32(_mm512_xor_si512(q, sign), sign));
+    }
+    break;
+  }
+  case DivStrategy::LargeDivisor: {
+    __m512i const one = _mm512_set1_epi32(1);
+    for (; i + 16 <= n; i += 16) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      __m512i const q = _mm512_maskz_mov_epi32(_mm512_cmpge_epu32_mask(_mm512_abs_epi32(x), abs_divisor), one);
+      __m512i const q_sign = _mm512_srai_epi32(_mm512_xor_si512(x, divisor), 31);
+      _mm512_storeu_si512(out + i, _mm512_sub_epi32(_mm512_xor_si512(q, q_sign), q_sign));
+    }
+    break;
+  }
+  }
+  scalar::divide(in + i, out + i, n - i, divider);
+}
+
+inline DIVTOMULTI_TARGET("avx512f") void divide(const uint64_t *in, uint64_t *out, size_t n, Divider<uint64_t> const &divider) {
+  __m512i const magic_lo = _mm512_set1_epi64(static_cast<long long>(divider.magic()));
+  __m512i const magic_hi = _mm512_set1_epi64(static_cast<long long>(divider.magic() >> 32));
+  __m512i const divisor = _mm512_set1_epi64(static_cast<long long>(divider.divisor()));
+  __m128i const shift = _mm_cvtsi32_si128(static_cast<int>(divider.shift()));
+
+  size_t i = 0;
+  switch (divider.strategy()) {
+  case DivStrategy::MulShift:
+    for (; i + 8 <= n; i += 8) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      _mm512_storeu_si512(out + i, _mm512_srl_epi64(mulhi_epu64(x, magic_lo, magic_hi), shift));
+    }
+    break;
+  case DivStrategy::MulAddShift:
+    for (; i + 8 <= n; i += 8) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      __m512i const high = mulhi_epu64(x, magic_lo, magic_hi);
+      __m512i const t = _mm512_add_epi64(high, _mm512_srli_epi64(_mm512_sub_epi64(x, high), 1));
+      _mm512_storeu_si512(out + i, _mm512_srl_epi64(t, shift));
+    }
+    break;
+  case DivStrategy::Pow2Shift:
+    for (; i + 8 <= n; i += 8) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      _mm512_storeu_si512(out + i, _mm512_srl_epi64(x, shift));
+    }
+    break;
+  case DivStrategy::LargeDivisor: {
+    __m512i const one = _mm512_set1_epi64(1);
+    for (; i + 8 <= n; i += 8) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      _mm512_storeu_si512(out + i, _mm512_maskz_mov_epi64(_mm512_cmpge_epu64_mask(x, divisor), one));
+    }
+    break;
+  }
+  }
+  scalar::divide(in + i, out + i, n - i, divider);
+}
+
+inline DIVTOMULTI_TARGET("avx512f") void divide(const int64_t *in, int64_t *out, size_t n, Divider<int64_t> const &divider) {
+  int64_t const d = divider.divisor();
+  int64_t const m = divider.magic();
+  uint64_t const abs_d = d < 0 ? 0U - static_cast<uint64_t>(d) : static_cast<uint64_t>(d);
+  __m512i const magic = _mm512_set1_epi64(m);
+  __m512i const magic_lo = magic;
+  __m512i const magic_hi = _mm512_set1_epi64(static_cast<long long>(static_cast<uint64_t>(m) >> 32));
+  __m512i const divisor = _mm512_set1_epi64(d);
+  __m512i const sign = _mm512_set1_epi64(d < 0 ? -1 : 0);
+  __m512i const abs_divisor = _mm512_set1_epi64(static_cast<long long>(abs_d));
+  __m128i const shift = _mm_cvtsi32_si128(static_cast<int>(divider.shift()));
+
+  size_t i = 0;
+  switch (divider.strategy()) {
+  case DivStrategy::MulShift:
+  case DivStrategy::MulAddShift: {
+    bool const add = divider.strategy() == DivStrategy::MulAddShift;
+    for (; i + 8 <= n; i += 8) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      // smulh(x, m) = umulh(x, m) - (x < 0 ? m : 0) - (m < 0 ? x : 0)
+      __m512i q = mulhi_epu64(x, magic_lo, magic_hi);
+      q = _mm512_sub_epi64(q, _mm512_and_si512(_mm512_srai_epi64(x, 63), magic));
+      if (m < 0) {
+        q = _mm512_sub_epi64(q, x);
+      }
+      if (add) {
+        q = _mm512_add_epi64(q, _mm512_sub_epi64(_mm512_xor_si512(x, sign), sign));
+      }
+      q = _mm512_sra_epi64(q, shift);
+      q = _mm512_add_epi64(q, _mm512_srli_epi64(q, 63));
+      _mm512_storeu_si512(out + i, q);
+    }
+    break;
+  }
+  case DivStrategy::Pow2Shift: {
+    __m512i const mask = _mm512_set1_epi64(static_cast<long long>(abs_d - 1));
+    for (; i + 8 <= n; i += 8) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      __m512i const sign_correction = _mm512_and_si512(_mm512_srai_epi64(x, 63), mask);
+      __m512i const q = _mm512_sra_epi64(_mm512_add_epi64(x, sign_correction), shift);
+      _mm512_storeu_si512(out + i, _mm512_sub_epi64(_mm512_xor_si512(q, sign), sign));
+    }
+    break;
+  }
+  case DivStrategy::LargeDivisor: {
+    __m512i const one = _mm512_set1_epi64(1);
+    for (; i + 8 <= n; i += 8) {
+      __m512i const x = _mm512_loadu_si512(in + i);
+      __m512i const q = _mm512_maskz_mov_epi64(_mm512_cmpge_epu64_mask(_mm512_abs_epi64(x), abs_divisor), one);
+      __m512i const q_sign = _mm512_srai_epi64(_mm512_xor_si512(x, divisor), 63);
+      _mm512_storeu_si512(out + i, _mm512_sub_epi64(_mm512_xor_si512(q, q_sign), q_sign));
+    }
+    break;
+  }
+  }
+  scalar::divide(in + i, out + i, n - i, divider);
+}
+
+inline DIVTOMULTI_TARGET("avx512f") void multiply_subtract(const uint32_t *in, const uint32_t *quotient, uint32_t *out, size_t n, uint32_t divisor) {
+  __m512i const d = _mm512_set1_epi32(static_cast<int>(divisor));
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512i const x = _mm512_loadu_si512(in + i);
+    __m512i const q = _mm512_loadu_si512(quotient + i);
+    _mm512_storeu_si512(out + i, _mm512_sub_epi32(x, _mm512_mullo_epi32(q, d)));
+  }
+  scalar::multiply_subtract(in + i, quotient + i, out + i, n - i, divisor);
+}
+
+} // namespace avx512
+
+// AVX-512DQ adds vpmullq, so the 64-bit multiply-subtract pass no longer has to go through scalar imul
+namespace avx512dq {
+
+inline DIVTOMULTI_TARGET("avx512f,avx512dq") void multiply_subtract(const uint64_t *in, const uint64_t *quotient, uint64_t *out, size_t n,
+                                                                    uint64_t divisor) {
+  __m512i const d = _mm512_set1_epi64(static_cast<long long>(divisor));
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512i const x = _mm512_loadu_si512(in + i);
+    __m512i const q = _mm512_loadu_si512(quotient + i);
+    _mm512_storeu_si512(out + i, _mm512_sub_epi64(x, _mm512_mullo_epi64(q, d)));
+  }
+  scalar::multiply_subtract(in + i, quotient + i, out + i, n - i, divisor);
+}
+
+} // namespace avx512dq
+
+#endif // DIVTOMULTI_X86
+
+#ifdef DIVTOMULTI_NEON
+
+namespace neon {
+
+inline uint32x4_t mulhi_u32(uint32x4_t a, uint32x2_t magic) {
+  uint64x2_t const lo = vmull_u32(vget_low_u32(a), magic);
+  uint64x2_t const hi = vmull_u32(vget_high_u32(a), magic);
+  return vcombine_u32(vshrn_n_u64(lo, 32), vshrn_n_u64(hi, 32));
+}
+
+inline int32x4_t mulhi_s32(int32x4_t a, int32x2_t magic) {
+  int64x2_t const lo = vmull_s32(vget_low_s32(a), magic);
+  int64x2_t const hi = vmull_s32(vget_high_s32(a), magic);
+  return vcombine_s32(vshrn_n_s64(lo, 32), vshrn_n_s64(hi, 32));
+}
+
+inline void divide(const uint32_t *in, uint32_t *out, size_t n, Divider<uint32_t> const &divider) {
+  uint32x2_t const magic = vdup_n_u32(divider.magic());
+  uint32x4_t const divisor = vdupq_n_u32(divider.divisor());
+  // vshl with a negative count shifts right
+  int32x4_t const shift = vdupq_n_s32(-static_cast<int32_t>(divider.shift()));
+
+  size_t i = 0;
+  switch (divider.strategy()) {
+  case DivStrategy::MulShift:
+    for (; i + 4 <= n; i += 4) {
+      uint32x4_t const x = vld1q_u32(in + i);
+      vst1q_u32(out + i, vshlq_u32(mulhi_u32(x, magic), shift));
+    }
+    break;
+  case DivStrategy::MulAddShift:
+    for (; i + 4 <= n; i += 4) {
+      uint32x4_t const x = vld1q_u32(in + i);
+      uint32x4_t const high = mulhi_u32(x, magic);
+      uint32x4_t const t = vaddq_u32(high, vshrq_n_u32(vsubq_u32(x, high), 1));
+      vst1q_u32(out + i, vshlq_u32(t, shift));
+    }
+    break;
+  case DivStrategy::Pow2Shift:
+    for (; i + 4 <= n; i += 4) {
+      vst1q_u32(out + i, vshlq_u32(vld1q_u32(in + i), shift));
+    }
+    break;
+  case DivStrategy::LargeDivisor:
+    for (; i + 4 <= n; i += 4) {
+      vst1q_u32(out + i, vshrq_n_u32(vcgeq_u32(vld1q_u32(in + i), divisor), 31));
+    }
+    break;
+  }
+  scalar::divide(in + i, out + i, n - i, divider);
+}
+
+inline void divide(const int32_t *in, int32_t *out, size_t n, Divider<int32_t> const &divider) {
+  int32_t const d = divider.divisor();
+  int32x2_t const magic = vdup_n_s32(divider.magic());
+  int32x4_t const divisor = vdupq_n_s32(d);
+  int32x4_t const sign = vdupq_n_s32(d < 0 ? -1 : 0);
+  uint32x4_t const abs_divisor = vdupq_n_u32(d < 0 ? 0U - static_cast<uint32_t>(d) : static_cast<uint32_t>(d));
+  int32x4_t const shift = vdupq_n_s32(-static_cast<int32_t>(divider.shift()));
+
+  size_t i = 0;
+  switch (divider.strategy()) {
+  case DivStrategy::MulShift:
+  case DivStrategy::MulAddShift: {
+    bool const add = divider.strategy() == DivStrategy::MulAddShift;
+    for (; i + 4 <= n; i += 4) {
+      int32x4_t const x = vld1q_s32(in + i);
+      int32x4_t q = mulhi_s32(x, magic);
+      if (add) {
+        q = vaddq_s32(q, vsubq_s32(veorq_s32(x, sign), sign));
+      }
+      q = vshlq_s32(q, shift);
+      q = vaddq_s32(q, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(q), 31)));
+      vst1q_s32(out + i, q);
+    }
+    break;
+  }
+  case DivStrategy::Pow2Shift: {
+    int32x4_t const mask = vreinterpretq_s32_u32(vsubq_u32(abs_divisor, vdupq_n_u32(1)));
+    for (; i + 4 <= n; i += 4) {
+      int32x4_t const x = vld1q_s32(in + i);
+      int32x4_t const sign_correction = vandq_s32(vshrq_n_s32(x, 31), mask);
+      int32x4_t const q = vshlq_s32(vaddq_s32(x, sign_correction), shift);
+      vst1q_s32(out + i, vsubq_s32(veorq_s32(q, sign), sign));
+    }
+    break;
+  }
+  case DivStrategy::LargeDivisor:
+    for (; i + 4 <= n; i += 4) {
+      int32x4_t const x = vld1q_s32(in + i);
+      uint32x4_t const abs_x = vreinterpretq_u32_s32(vabsq_s32(x));
+      int32x4_t const q = vreinterpretq_s32_u32(vshrq_n_u32(vcgeq_u32(abs_x, abs_divisor), 31));
+      int32x4_t const q_sign = vshrq_n_s32(veorq_s32(x, divisor), 31);
+      vst1q_s32(out + i, vsubq_s32(veorq_s32(q, q_sign), q_sign));
+    }
+    break;
+  }
+  scalar::divide(in + i, out + i, n - i, divider);
+}
+
+// AArch64 has a scalar 64x64 multiply-high (umulh/smulh); two-lane emulation would be slower
+inline void divide(const uint64_t *in, uint64_t *out, size_t n, Divider<uint64_t> const &divider) {
+  scalar::divide(in, out, n, divider);
+}
+
+inline void divide(const int64_t *in, int64_t *out, size_t n, Divider<int64_t> const &divider) {
+  scalar::divide(in, out, n, divider);
+}
+
+inline void multiply_subtract(const uint32_t *in, const uint32_t *quotient, uint32_t *out, size_t n, uint32_t divisor) {
+  uint32x4_t const d = vdupq_n_u32(divisor);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1q_u32(out + i, vmlsq_u32(vld1q_u32(in + i), vld1q_u32(quotient + i), d));
+  }
+  scalar::multiply_subtract(in + i, quotient + i, out + i, n - i, divisor);
+}
+
+} // namespace neon
+
+#endif // DIVTOMULTI_NEON
+
+} // namespace batch
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+#include "divider.h"
+
+// =============================================================================
+// Divider cache
+// =============================================================================
+
+struct DividerCacheStats {
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t evictions;
+};
+
+// Counter stripes per cache; one more is shared by any threads beyond these
+constexpr size_t kCounterStripes = 16;
+
+// Hands out stripe indices to threads and takes them back when they exit, so
+// no two live threads own the same stripe
+class CounterStripePool {
+public:
+  size_t acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < kCounterStripes; ++i) {
+      if (!used_[i]) {
+        used_[i] = true;
+        return i;
+      }
+    }
+    return kCounterStripes;
+  }
+
+  void release(size_t stripe) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stripe < kCounterStripes) {
+      used_[stripe] = false;
+    }
+  }
+
+private:
+  std::mutex mutex_;
+  bool used_[kCounterStripes] = {};
+};
+
+inline CounterStripePool &counter_stripe_pool() {
+  static CounterStripePool pool;
+  return pool;
+}
+
+// This thread's stripe: below kCounterStripes it has a single writer, so
+// counting is a relaxed load and store instead of a locked read-modify-write.
+// kCounterStripes means the shared overflow stripe.
+inline size_t counter_stripe() {
+  struct Claim {
+    size_t stripe = counter_stripe_pool().acquire();
+    ~Claim() {
+      counter_stripe_pool().release(stripe);
+    }
+  };
+  thread_local Claim const claim;
+  return claim.stripe;
+}
+
+// Maps runtime divisors to their strategy, magic number and shift, for
+// workloads that keep dividing by a small, slowly changing set of divisors.
+//
+// Open-addressed, power-of-two sized, probing at most kProbe slots from the
+// divisor's home slot. A slot holds all of a Divider's state, so a hit copies
+// it out with no magic-number arithmetic. A miss computes Divider(divisor) and inserts it
+// into an empty slot in the window, or evicts the window's oldest entry. Each
+// slot is a seqlock: lookups never write to the table and never block, and
+// an insert that finds its slot already being written just gives up. The
+// hit and miss counters are per thread (see counter_stripe()).
+template <typename IntType> class DividerCache {
+  using UIntType = typename std::make_unsigned<IntType>::type;
+
+public:
+  static constexpr size_t kProbe = 4;
+
+  // capacity is rounded up to a power of two, at least kProbe
+  explicit DividerCache(size_t capacity = 1024) {
+    size_t size = kProbe;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    mask_ = size - 1;
+    slots_.reset(new Slot[size]);
+  }
+
+  DividerCache(DividerCache const &) = delete;
+  DividerCache &operator=(DividerCache const &) = delete;
+
+  Divider<IntType> get(IntType divisor) {
+    assert(divisor != 0 && "Divisor must not be 0");
+    UIntType const key = static_cast<UIntType>(divisor);
+    size_t const home = home_slot(key);
+    for (size_t i = 0; i < kProbe; ++i) {
+      Entry entry;
+      if (slots_[(home + i) & mask_].read(entry) && entry.key == key) {
+        count(&CounterStripe::hits);
+        return Divider<IntType>(divisor, static_cast<DivStrategy>(entry.meta >> 8), static_cast<IntType>(entry.magic), entry.meta & 0xFFU);
+      }
+    }
+    count(&CounterStripe::misses);
+    Divider<IntType> const divider(divisor);
+    insert(home, key, divider);
+    return divider;
+  }
+
+  size_t capacity() const {
+    return mask_ + 1;
+  }
+
+  // Exact once the counting threads are joined; a reset_stats() racing a
+  // lookup may miss that lookup's count
+  DividerCacheStats stats() const {
+    DividerCacheStats total{0, 0, 0};
+    for (auto const &stripe : stripes_) {
+      total.hits += stripe.hits.load(std::memory_order_relaxed);
+      total.misses += stripe.misses.load(std::memory_order_relaxed);
+      total.evictions += stripe.evictions.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  void reset_stats() {
+    for (auto &stripe : stripes_) {
+      stripe.hits.store(0, std::memory_order_relaxed);
+      stripe.misses.store(0, std::memory_order_relaxed);
+      stripe.evictions.store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  struct Entry {
+    UIntType key;
+    UIntType magic;
+    uint16_t meta; // strategy << 8 | shift
+  };
+
+  // Every field is atomic so a read racing a write is a retry, not undefined behaviour
+  struct Slot {
+    std::atomic<uint32_t> seq{0}; // odd while an insert is writing the slot
+    std::atomic<UIntType> key{0}; // 0 is never a valid divisor: empty slot
+    std::atomic<UIntType> magic{0};
+    std::atomic<uint16_t> meta{0};
+    std::atomic<uint64_t> stamp{0}; // insertion order, for eviction
+
+    bool read(Entry &entry) const {
+      uint32_t const before = seq.load(std::memory_order_acquire);
+      if (before & 1U) {
+        return false;
+      }
+      entry.key = key.load(std::memory_order_relaxed);
+      entry.magic = magic.load(std::memory_order_relaxed);
+      entry.meta = meta.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return seq.load(std::memory_order_relaxed) == before;
+    }
+  };
+
+  struct alignas(64) CounterStripe {
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> evictions{0};
+  };
+
+  void count(std::atomic<uint64_t> CounterStripe::*counter) {
+    size_t const stripe = counter_stripe();
+    std::atomic<uint64_t> &value = stripes_[stripe].*counter;
+    if (stripe < kCounterStripes) {
+      value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    } else {
+      value.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  size_t home_slot(UIntType key) const {
+    // Fibonacci hashing: small and strided divisors spread over the whole table
+    return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> 32) & mask_;
+  }
+
+  void insert(size_t home, UIntType key, Divider<IntType> const &divider) {
+    Slot *victim = nullptr;
+    for (size_t i = 0; i < kProbe; ++i) {
+      Slot &slot = slots_[(home + i) & mask_];
+      UIntType const occupant = slot.key.load(std::memory_order_relaxed);
+      if (occupant == key) {
+        return; // another thread got here first
+      }
+      if (occupant == 0) {
+        victim = &slot;
+        break;
+      }
+      if (victim == nullptr || slot.stamp.load(std::memory_order_relaxed) < victim->stamp.load(std::memory_order_relaxed)) {
+        victim = &slot;
+      }
+    }
+
+    uint32_t seq = victim->seq.load(std::memory_order_relaxed);
+    if ((seq & 1U) || !victim->seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) {
+      return; // being written by another insert; the next miss retries
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    if (victim->key.load(std::memory_order_relaxed) != 0) {
+      count(&CounterStripe::evictions);
+    }
+    victim->key.store(key, std::memory_order_relaxed);
+    victim->magic.store(static_cast<UIntType>(divider.magic()), std::memory_order_relaxed);
+    victim->meta.store(static_cast<uint16_t>(static_cast<unsigned>(divider.strategy()) << 8 | divider.shift()), std::memory_order_relaxed);
+    victim->stamp.store(clock_.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    victim->seq.store(seq + 2, std::memory_order_release);
+  }
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_;
+  std::atomic<uint64_t> clock_{0};
+  CounterStripe stripes_[kCounterStripes + 1];
+};
+
+// Process-wide cache used by the opt_cal_cached family when no cache is passed
+template <typename IntType> DividerCache<IntType> &default_divider_cache() {
+  static DividerCache<IntType> cache;
+  return cache;
+}
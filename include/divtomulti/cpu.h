@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+
+#include "intrinsics.h"
+
+// =============================================================================
+// CPU feature detection
+// =============================================================================
+
+// Features probed once at startup; the dispatch table below binds kernels from them
+struct CpuFeatures {
+  bool sse41 = false;
+  bool avx2 = false;
+  bool fma = false; // vfmadd on doubles, for the floating-point reciprocal kernels
+  bool bmi2 = false; // mulx: flag-free 64x64->128 multiply for the scalar paths
+  bool avx512f = false;
+  bool avx512dq = false; // vpmullq: native 64-bit low multiply for batch remainders
+  bool avx512ifma = false;
+  bool neon = false;
+};
+
+#ifdef DIVTOMULTI_X86
+inline void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#ifdef _MSC_VER
+  int r[4];
+  __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+  for (int i = 0; i < 4; ++i) {
+    regs[i] = static_cast<uint32_t>(r[i]);
+  }
+#else
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+inline uint64_t xgetbv0() {
+#ifdef _MSC_VER
+  return _xgetbv(0);
+#else
+  uint32_t eax;
+  uint32_t edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+inline CpuFeatures detect_cpu_features() {
+  CpuFeatures features;
+#if defined(DIVTOMULTI_X86)
+  uint32_t regs[4];
+  cpuid(0, 0, regs);
+  uint32_t const max_leaf = regs[0];
+
+  cpuid(1, 0, regs);
+  bool const osxsave = (regs[2] & (1U << 27)) != 0;
+  bool const avx = (regs[2] & (1U << 28)) != 0;
+  bool const fma = (regs[2] & (1U << 12)) != 0;
+  features.sse41 = (regs[2] & (1U << 19)) != 0;
+
+  // The OS has to save the YMM (and ZMM/opmask) state, not just the CPU support it
+  uint64_t const xcr0 = osxsave ? xgetbv0() : 0;
+  bool const os_avx = (xcr0 & 0x6) == 0x6;
+  bool const os_avx512 = (xcr0 & 0xE6) == 0xE6;
+
+  uint32_t ebx7 = 0;
+  if (max_leaf >= 7) {
+    cpuid(7, 0, regs);
+    ebx7 = regs[1];
+  }
+
+  features.bmi2 = (ebx7 & (1U << 8)) != 0;
+  features.avx2 = avx && os_avx && (ebx7 & (1U << 5)) != 0;
+  features.fma = avx && os_avx && fma;
+  features.avx512f = os_avx512 && (ebx7 & (1U << 16)) != 0;
+  features.avx512dq = features.avx512f && (ebx7 & (1U << 17)) != 0;
+  features.avx512ifma = features.avx512f && (ebx7 & (1U << 21)) != 0;
+#elif defined(DIVTOMULTI_NEON)
+  features.neon = true;
+#endif
+  return features;
+}
+
+inline CpuFeatures const &cpu_features() {
+  static CpuFeatures const features = detect_cpu_features();
+  return features;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "divider.h"
+#include "intrinsics.h"
+
+// =============================================================================
+// Decimal formatting
+// =============================================================================
+
+// Integer to ASCII without a hardware divide: every split goes through
+// ConstDivider, so it is a multiply-high and a shift. u64 is cut into 8-digit
+// groups by 10^8, a group into halves by 10^4, and a half into digit pairs
+// by 100, each pair copied from a 200-byte table.
+
+// Most characters format_decimal writes for one value, sign included
+template <typename IntType> constexpr size_t max_decimal_chars() {
+  return static_cast<size_t>(std::numeric_limits<IntType>::digits10) + 1 + (std::numeric_limits<IntType>::is_signed ? 1 : 0);
+}
+
+inline char const *decimal_pairs() {
+  static constexpr char kPairs[] = "00010203040506070809"
+                                   "10111213141516171819"
+                                   "20212223242526272829"
+                                   "30313233343536373839"
+                                   "40414243444546474849"
+                                   "50515253545556575859"
+                                   "60616263646566676869"
+                                   "70717273747576777879"
+                                   "80818283848586878889"
+                                   "90919293949596979899";
+  return kPairs;
+}
+
+// Digit count from the bit length: bits * 1233 / 4096 approximates
+// bits * log10(2), which is exact or one short; a table compare settles it
+inline unsigned decimal_digits(uint64_t value) {
+  static constexpr uint64_t kPowers[] = {0,
+                                         10ULL,
+                                         100ULL,
+                                         1000ULL,
+                                         10000ULL,
+                                         100000ULL,
+                                         1000000ULL,
+                                         10000000ULL,
+                                         100000000ULL,
+                                         1000000000ULL,
+                                         10000000000ULL,
+                                         100000000000ULL,
+                                         1000000000000ULL,
+                                         10000000000000ULL,
+                                         100000000000000ULL,
+                                         1000000000000000ULL,
+                                         10000000000000000ULL,
+                                         100000000000000000ULL,
+                                         1000000000000000000ULL,
+                                         10000000000000000000ULL};
+  unsigned const bits = 64U - static_cast<unsigned>(clzll(value | 1));
+  unsigned const t = (bits * 1233U) >> 12;
+  return t + 1 - (value < kPowers[t] ? 1U : 0U);
+}
+
+// Exactly two digits, value < 100
+inline void write_decimal_2(uint32_t value, char *out) {
+  std::memcpy(out, decimal_pairs() + 2 * value, 2);
+}
+
+// Exactly four digits, value < 10^4
+inline void write_decimal_4(uint32_t value, char *out) {
+  uint32_t const high = ConstDivider<uint32_t, 100>::divide(value);
+  write_decimal_2(high, out);
+  write_decimal_2(value - high * 100, out + 2);
+}
+
+// Exactly eight digits, value < 10^8
+inline void write_decimal_8(uint32_t value, char *out) {
+  uint32_t const high = ConstDivider<uint32_t, 10000>::divide(value);
+  write_decimal_4(high, out);
+  write_decimal_4(value - high * 10000, out + 4);
+}
+
+// Writes the digits of value (no terminator) and returns one past the last one
+inline char *format_decimal(uint32_t value, char *out) {
+  char *const end = out + decimal_digits(value);
+  char *p = end;
+  while (value >= 100) {
+    uint32_t const high = ConstDivider<uint32_t, 100>::divide(value);
+    p -= 2;
+    write_decimal_2(value - high * 100, p);
+    value = high;
+  }
+  if (value >= 10) {
+    write_decimal_2(value, p - 2);
+  } else {
+    p[-1] = static_cast<char>('0' + value);
+  }
+  return end;
+}
+
+inline char *format_decimal(uint64_t value, char *out) {
+  if (value <= UINT32_MAX) {
+    return format_decimal(static_cast<uint32_t>(value), out);
+  }
+  // At most 12 leading digits, then a full group of 8
+  uint64_t const high = ConstDivider<uint64_t, 100000000>::divide(value);
+  uint32_t const low = static_cast<uint32_t>(value - high * 100000000);
+  if (high <= UINT32_MAX) {
+    out = format_decimal(static_cast<uint32_t>(high), out);
+  } else {
+    uint64_t const top = ConstDivider<uint64_t, 100000000>::divide(high);
+    out = format_decimal(static_cast<uint32_t>(top), out);
+    write_decimal_8(static_cast<uint32_t>(high - top * 100000000), out);
+    out += 8;
+  }
+  write_decimal_8(low, out);
+  return out + 8;
+}
+
+inline char *format_decimal(int32_t value, char *out) {
+  *out = '-';
+  uint32_t const sign = static_cast<uint32_t>(value >> 31);
+  return format_decimal((static_cast<uint32_t>(value) ^ sign) - sign, out + (sign & 1));
+}
+
+inline char *format_decimal(int64_t value, char *out) {
+  *out = '-';
+  uint64_t const sign = static_cast<uint64_t>(value >> 63);
+  return format_decimal((static_cast<uint64_t>(value) ^ sign) - sign, out + (sign & 1));
+}
+
+// Formats n values into one contiguous buffer, each followed by separator.
+// out must hold n * (max_decimal_chars<IntType>() + 1) characters; returns one
+// past the last character written.
+template <typename IntType> char *format_decimal(const IntType *in, size_t n, char *out, char separator = '\n') {
+  for (size_t i = 0; i < n; ++i) {
+    out = format_decimal(in[i], out);
+    *out++ = separator;
+  }
+  return out;
+}
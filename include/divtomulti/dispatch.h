@@ -0,0 +1,222 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "batch.h"
+#include "cpu.h"
+#include "divider.h"
+#include "fpdiv.h"
+
+// =============================================================================
+// Runtime dispatch
+// =============================================================================
+
+// Kernel tiers, from the portable scalar code up to the widest vectors. A tier
+// also decides the scalar kernel (mulx from BMI2 upward, when present).
+enum class DispatchTier : uint8_t {
+  Scalar,
+  BMI2,
+  SSE41,
+  AVX2,
+  AVX512,
+  NEON,
+};
+
+template <typename IntType> struct DivisionKernels {
+  IntType (*divide)(IntType dividend, Divider<IntType> const &divider);
+  void (*divide_batch)(const IntType *in, IntType *out, size_t n, Divider<IntType> const &divider);
+  void (*remainder_batch)(const IntType *in, IntType *out, size_t n, Divider<IntType> const &divider);
+  void (*divmod_batch)(const IntType *in, IntType *quotient, IntType *remainder, size_t n, Divider<IntType> const &divider);
+};
+
+// FloatDivider<T> batch kernels, 32-bit widths only
+template <typename IntType> struct FloatKernels {
+  void (*divide_batch)(const IntType *in, IntType *out, size_t n, FloatDivider<IntType> const &divider);
+  void (*remainder_batch)(const IntType *in, IntType *out, size_t n, FloatDivider<IntType> const &divider);
+};
+
+struct DispatchTable {
+  DispatchTier tier;
+  DivisionKernels<uint32_t> u32;
+  DivisionKernels<int32_t> i32;
+  DivisionKernels<uint64_t> u64;
+  DivisionKernels<int64_t> i64;
+  FloatKernels<uint32_t> float_u32;
+  FloatKernels<int32_t> float_i32;
+};
+
+inline bool dispatch_tier_supported(DispatchTier tier, CpuFeatures const &features) {
+  switch (tier) {
+  case DispatchTier::Scalar:
+    return true;
+  case DispatchTier::BMI2:
+    return features.bmi2;
+  case DispatchTier::SSE41:
+    return features.sse41;
+  case DispatchTier::AVX2:
+    return features.avx2;
+  case DispatchTier::AVX512:
+    return features.avx512f;
+  case DispatchTier::NEON:
+    return features.neon;
+  }
+  return false;
+}
+
+inline DispatchTier best_dispatch_tier(CpuFeatures const &features) {
+  DispatchTier const preference[] = {DispatchTier::AVX512, DispatchTier::AVX2, DispatchTier::SSE41, DispatchTier::NEON, DispatchTier::BMI2};
+  for (DispatchTier tier : preference) {
+    if (dispatch_tier_supported(tier, features)) {
+      return tier;
+    }
+  }
+  return DispatchTier::Scalar;
+}
+
+// Points the batch kernels at one vector namespace's quotient kernel and the
+// shared blocked remainder/divmod built on it
+template <typename IntType, batch::DivideKernel<IntType> Divide, batch::MultiplySubtractKernel<uint32_t> MultiplySubtract32,
+          batch::MultiplySubtractKernel<uint64_t> MultiplySubtract64>
+void bind_vector_kernels(DivisionKernels<IntType> &kernels) {
+  kernels.divide_batch = Divide;
+  kernels.remainder_batch = &batch::blocked_remainder<IntType, Divide, MultiplySubtract32, MultiplySubtract64>;
+  kernels.divmod_batch = &batch::blocked_divmod<IntType, Divide, MultiplySubtract32, MultiplySubtract64>;
+}
+
+template <typename IntType> DivisionKernels<IntType> make_division_kernels(DispatchTier tier, CpuFeatures const &features) {
+  static_cast<void>(features);
+  DivisionKernels<IntType> kernels;
+  kernels.divide = &batch::scalar::divide<IntType>;
+  kernels.divide_batch = &batch::scalar::divide<IntType>;
+  kernels.remainder_batch = &batch::scalar::remainder<IntType>;
+  kernels.divmod_batch = &batch::scalar::divmod<IntType>;
+
+#ifdef DIVTOMULTI_X86
+  if (tier != DispatchTier::Scalar && features.bmi2) {
+    kernels.divide = &batch::bmi2::divide<IntType>;
+    kernels.divide_batch = &batch::bmi2::divide<IntType>;
+    kernels.remainder_batch = &batch::bmi2::remainder<IntType>;
+    kernels.divmod_batch = &batch::bmi2::divmod<IntType>;
+  }
+#endif
+
+  switch (tier) {
+#ifdef DIVTOMULTI_X86
+  case DispatchTier::SSE41:
+    bind_vector_kernels<IntType, batch::sse41::divide, batch::sse41::multiply_subtract, nullptr>(kernels);
+    break;
+  case DispatchTier::AVX2:
+    bind_vector_kernels<IntType, batch::avx2::divide, batch::avx2::multiply_subtract, nullptr>(kernels);
+    break;
+  case DispatchTier::AVX512:
+    if (features.avx512dq) {
+      bind_vector_kernels<IntType, batch::avx512::divide, batch::avx512::multiply_subtract, batch::avx512dq::multiply_subtract>(kernels);
+    } else {
+      bind_vector_kernels<IntType, batch::avx512::divide, batch::avx512::multiply_subtract, nullptr>(kernels);
+    }
+    break;
+#endif
+#ifdef DIVTOMULTI_NEON
+  case DispatchTier::NEON:
+    bind_vector_kernels<IntType, batch::neon::divide, batch::neon::multiply_subtract, nullptr>(kernels);
+    break;
+#endif
+  default:
+    break;
+  }
+  return kernels;
+}
+
+// The AVX2 kernels also need FMA, which the AVX2 and AVX512 tiers do not imply
+template <typename IntType> FloatKernels<IntType> make_float_kernels(DispatchTier tier, CpuFeatures const &features) {
+  static_cast<void>(tier);
+  static_cast<void>(features);
+  FloatKernels<IntType> kernels;
+  kernels.divide_batch = &fpdiv::scalar::divide<IntType>;
+  kernels.remainder_batch = &fpdiv::scalar::remainder<IntType>;
+#ifdef DIVTOMULTI_X86
+  if ((tier == DispatchTier::AVX2 || tier == DispatchTier::AVX512) && features.fma) {
+    kernels.divide_batch = &fpdiv::avx2::divide<IntType>;
+    kernels.remainder_batch = &fpdiv::avx2::remainder<IntType>;
+  }
+#endif
+  return kernels;
+}
+
+inline DispatchTable make_dispatch_table(DispatchTier tier, CpuFeatures const &features) {
+  DispatchTable table;
+  table.tier = tier;
+  table.u32 = make_division_kernels<uint32_t>(tier, features);
+  table.i32 = make_division_kernels<int32_t>(tier, features);
+  table.u64 = make_division_kernels<uint64_t>(tier, features);
+  table.i64 = make_division_kernels<int64_t>(tier, features);
+  table.float_u32 = make_float_kernels<uint32_t>(tier, features);
+  table.float_i32 = make_float_kernels<int32_t>(tier, features);
+  return table;
+}
+
+// One table per tier, built once; only the ones this CPU supports are ever bound
+inline DispatchTable const &dispatch_table_for(DispatchTier tier) {
+  static DispatchTable const tables[] = {
+      make_dispatch_table(DispatchTier::Scalar, cpu_features()), make_dispatch_table(DispatchTier::BMI2, cpu_features()),
+      make_dispatch_table(DispatchTier::SSE41, cpu_features()),  make_dispatch_table(DispatchTier::AVX2, cpu_features()),
+      make_dispatch_table(DispatchTier::AVX512, cpu_features()), make_dispatch_table(DispatchTier::NEON, cpu_features()),
+  };
+  return tables[static_cast<size_t>(tier)];
+}
+
+inline std::atomic<DispatchTable const *> &active_dispatch_table() {
+  static std::atomic<DispatchTable const *> active{&dispatch_table_for(best_dispatch_tier(cpu_features()))};
+  return active;
+}
+
+// The table bound at startup (or by force_dispatch_tier). Callers index it
+// directly, so no call branches on CPU features.
+inline DispatchTable const &dispatch() {
+  return *active_dispatch_table().load(std::memory_order_acquire);
+}
+
+// The bound kernels for one width, for code templated on the integer type
+template <typename IntType> DivisionKernels<IntType> const &dispatch_kernels();
+
+template <> inline DivisionKernels<uint32_t> const &dispatch_kernels<uint32_t>() {
+  return dispatch().u32;
+}
+
+template <> inline DivisionKernels<int32_t> const &dispatch_kernels<int32_t>() {
+  return dispatch().i32;
+}
+
+template <> inline DivisionKernels<uint64_t> const &dispatch_kernels<uint64_t>() {
+  return dispatch().u64;
+}
+
+template <> inline DivisionKernels<int64_t> const &dispatch_kernels<int64_t>() {
+  return dispatch().i64;
+}
+
+template <typename IntType> FloatKernels<IntType> const &dispatch_float_kernels();
+
+template <> inline FloatKernels<uint32_t> const &dispatch_float_kernels<uint32_t>() {
+  return dispatch().float_u32;
+}
+
+template <> inline FloatKernels<int32_t> const &dispatch_float_kernels<int32_t>() {
+  return dispatch().float_i32;
+}
+
+// Rebinds every dispatched call to `tier`, for testing. Returns false (and
+// changes nothing) if this CPU cannot run the tier.
+inline bool force_dispatch_tier(DispatchTier tier) {
+  if (!dispatch_tier_supported(tier, cpu_features())) {
+    return false;
+  }
+  active_dispatch_table().store(&dispatch_table_for(tier), std::memory_order_release);
+  return true;
+}
+
+inline void reset_dispatch_tier() {
+  force_dispatch_tier(best_dispatch_tier(cpu_features()));
+}
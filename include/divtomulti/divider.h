@@ -0,0 +1,507 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+#include "intrinsics.h"
+#include "magic.h"
+
+// =============================================================================
+// Precomputed divider
+// =============================================================================
+
+// Division strategy selected once per divisor by Divider<T>
+enum class DivStrategy : uint8_t {
+  MulShift,     // multiply-high, then shift
+  MulAddShift,  // multiply-high with add-indicator (or signed magic overflow) correction, then shift
+  Pow2Shift,    // |divisor| is a power of two (including 1): shift only
+  LargeDivisor, // |divisor| > MAX/2: the quotient magnitude is 0 or 1, a compare is enough
+};
+
+// Quotient and remainder of one division
+template <typename IntType> struct DivMod {
+  IntType quotient;
+  IntType remainder;
+};
+
+template <typename IntType, bool = std::is_signed<IntType>::value> class Divider;
+
+// Unsigned divider: the magic number is computed once in the constructor and
+// divide()/remainder() only dispatch on the stored strategy.
+template <typename UIntType> class Divider<UIntType, false> {
+public:
+  explicit Divider(UIntType divisor) : divisor_(divisor) {
+    assert(divisor != 0 && "Divisor must not be 0");
+
+    if ((divisor & (divisor - 1)) == 0) {
+      strategy_ = DivStrategy::Pow2Shift;
+      shift_ = sizeof(UIntType) == 4 ? ctz(static_cast<uint32_t>(divisor)) : static_cast<unsigned>(ctzll(divisor));
+    } else if (divisor > (static_cast<UIntType>(-1) >> 1)) {
+      strategy_ = DivStrategy::LargeDivisor;
+    } else {
+      auto const dm = get_unsigned_magic_fast(divisor);
+      magic_ = dm.magic;
+      shift_ = dm.shift;
+      strategy_ = dm.is_add ? DivStrategy::MulAddShift : DivStrategy::MulShift;
+    }
+  }
+
+  // Rebuilds a divider from parts an earlier Divider(divisor) computed (see DividerCache)
+  Divider(UIntType divisor, DivStrategy strategy, UIntType magic, unsigned shift)
+      : divisor_(divisor), magic_(magic), shift_(shift), strategy_(strategy) {
+  }
+
+  UIntType divide(UIntType dividend) const {
+    switch (strategy_) {
+    case DivStrategy::MulShift:
+      return umulh(dividend, magic_) >> shift_;
+    case DivStrategy::MulAddShift: {
+      // (high + ((dividend - high) >> 1)) >> shift
+      UIntType const high = umulh(dividend, magic_);
+      return (high + ((dividend - high) >> 1)) >> shift_;
+    }
+    case DivStrategy::Pow2Shift:
+      return dividend >> shift_;
+    default:
+      return dividend >= divisor_ ? 1 : 0;
+    }
+  }
+
+  UIntType remainder(UIntType dividend) const {
+    return dividend - divisor_ * divide(dividend);
+  }
+
+  // One multiply-high for both: the remainder reuses the quotient
+  DivMod<UIntType> divmod(UIntType dividend) const {
+    UIntType const quotient = divide(dividend);
+    return {quotient, static_cast<UIntType>(dividend - divisor_ * quotient)};
+  }
+
+  UIntType divisor() const {
+    return divisor_;
+  }
+  UIntType magic() const {
+    return magic_;
+  }
+  unsigned shift() const {
+    return shift_;
+  }
+  DivStrategy strategy() const {
+    return strategy_;
+  }
+
+private:
+  UIntType divisor_;
+  UIntType magic_ = 0;
+  unsigned shift_ = 0;
+  DivStrategy strategy_;
+};
+
+// Signed divider, truncating toward zero like the built-in operator.
+// INT_MIN / -1 wraps to INT_MIN, the same as opt_cal_signed.
+template <typename SIntType> class Divider<SIntType, true> {
+  using UIntType = typename std::make_unsigned<SIntType>::type;
+  static constexpr unsigned B = sizeof(SIntType) * 8;
+
+public:
+  explicit Divider(SIntType divisor)
+      : divisor_(divisor), abs_divisor_(divisor < 0 ? 0U - static_cast<UIntType>(divisor) : static_cast<UIntType>(divisor)),
+        sign_(divisor < 0 ? -1 : 0) {
+    assert(divisor != 0 && "Divisor must not be 0");
+
+    if ((abs_divisor_ & (abs_divisor_ - 1)) == 0) {
+      strategy_ = DivStrategy::Pow2Shift;
+      shift_ = sizeof(SIntType) == 4 ? ctz(static_cast<uint32_t>(abs_divisor_)) : static_cast<unsigned>(ctzll(abs_divisor_));
+    } else if (abs_divisor_ > (static_cast<UIntType>(-1) >> 2)) {
+      strategy_ = DivStrategy::LargeDivisor;
+    } else {
+      auto const dm = get_signed_magic(divisor);
+      magic_ = dm.magic;
+      shift_ = dm.shift;
+      // Magic overflowed into the sign bit: the dividend has to be added (or subtracted) back
+      bool const needs_add = (divisor > 0 && dm.magic < 0) || (divisor < 0 && dm.magic > 0);
+      strategy_ = needs_add ? DivStrategy::MulAddShift : DivStrategy::MulShift;
+    }
+  }
+
+  Divider(SIntType divisor, DivStrategy strategy, SIntType magic, unsigned shift)
+      : divisor_(divisor), abs_divisor_(divisor < 0 ? 0U - static_cast<UIntType>(divisor) : static_cast<UIntType>(divisor)),
+        sign_(divisor < 0 ? -1 : 0), magic_(magic), shift_(shift), strategy_(strategy) {
+  }
+
+  SIntType divide(SIntType dividend) const {
+    switch (strategy_) {
+    case DivStrategy::MulShift:
+    case DivStrategy::MulAddShift: {
+      UIntType q = static_cast<UIntType>(smulh(dividend, magic_));
+      if (strategy_ == DivStrategy::MulAddShift) {
+        // +dividend for positive divisors, -dividend for negative ones
+        q += negate_if(static_cast<UIntType>(dividend));
+      }
+      // Arithmetic shift right, then round toward zero
+      SIntType const shifted = static_cast<SIntType>(q) >> shift_;
+      return static_cast<SIntType>(static_cast<UIntType>(shifted) + (static_cast<UIntType>(shifted) >> (B - 1)));
+    }
+    case DivStrategy::Pow2Shift: {
+      SIntType const sign_correction = (dividend >> (B - 1)) & static_cast<SIntType>(abs_divisor_ - 1);
+      SIntType const q = static_cast<SIntType>(static_cast<UIntType>(dividend) + static_cast<UIntType>(sign_correction)) >> shift_;
+      return static_cast<SIntType>(negate_if(static_cast<UIntType>(q)));
+    }
+    default: {
+      UIntType const u_dividend = static_cast<UIntType>(dividend);
+      UIntType const u_abs_dividend = dividend < 0 ? 0U - u_dividend : u_dividend;
+      UIntType const q = u_abs_dividend >= abs_divisor_ ? 1U : 0U;
+      UIntType const q_sign = static_cast<UIntType>((dividend ^ divisor_) >> (B - 1));
+      return static_cast<SIntType>((q ^ q_sign) - q_sign);
+    }
+    }
+  }
+
+  SIntType remainder(SIntType dividend) const {
+    UIntType const quotient = static_cast<UIntType>(divide(dividend));
+    return static_cast<SIntType>(static_cast<UIntType>(dividend) - static_cast<UIntType>(divisor_) * quotient);
+  }
+
+  DivMod<SIntType> divmod(SIntType dividend) const {
+    SIntType const quotient = divide(dividend);
+    return {quotient, static_cast<SIntType>(static_cast<UIntType>(dividend) - static_cast<UIntType>(divisor_) * static_cast<UIntType>(quotient))};
+  }
+
+  SIntType divisor() const {
+    return divisor_;
+  }
+  SIntType magic() const {
+    return magic_;
+  }
+  unsigned shift() const {
+    return shift_;
+  }
+  DivStrategy strategy() const {
+    return strategy_;
+  }
+
+private:
+  // Two's complement negation when the divisor is negative, computed on the unsigned type so INT_MIN wraps
+  UIntType negate_if(UIntType value) const {
+    UIntType const sign = static_cast<UIntType>(sign_);
+    return (value ^ sign) - sign;
+  }
+
+  SIntType divisor_;
+  UIntType abs_divisor_;
+  SIntType sign_;
+  SIntType magic_ = 0;
+  unsigned shift_ = 0;
+  DivStrategy strategy_;
+};
+
+// =============================================================================
+// Divisibility test
+// =============================================================================
+
+// dividend % divisor == 0 with one multiply and a rotate, no quotient needed
+// (Granlund-Montgomery). Kept apart from Divider<T> so that building a
+// Divider does not pay for the inverse; build one of these for divisors that
+// are tested more than divided.
+template <typename IntType> class DivisibilityTester {
+  using UIntType = typename std::make_unsigned<IntType>::type;
+
+public:
+  explicit DivisibilityTester(IntType divisor) : divisor_(divisor), dm_(make_magic(divisor)) {
+    assert(divisor != 0 && "Divisor must not be 0");
+  }
+
+  bool is_divisible(IntType dividend) const {
+    UIntType const x = static_cast<UIntType>(static_cast<UIntType>(dividend) * dm_.inverse + dm_.bias);
+    return rotate_right(x, dm_.shift) <= dm_.limit;
+  }
+
+  IntType divisor() const {
+    return divisor_;
+  }
+
+private:
+  static DivisibilityMagic<UIntType> make_magic(IntType divisor) {
+    if constexpr (std::is_signed<IntType>::value) {
+      return get_signed_divisibility_magic(divisor);
+    } else {
+      return get_unsigned_divisibility_magic(divisor);
+    }
+  }
+
+  IntType divisor_;
+  DivisibilityMagic<UIntType> dm_; // bias is 0 for unsigned widths
+};
+
+// =============================================================================
+// Branch-free signed divider
+// =============================================================================
+
+// Signed divider whose divide() is one straight-line sequence for every
+// divisor, for streams where the divisor changes per element and Divider<T>'s
+// strategy switch would mispredict. Every case is encoded as
+// (magic, add mask, bias, shift, sign):
+//   q = smulh(n, magic) + (n & add_mask)
+//   q = (q + (q < 0 ? bias : 0)) >> shift
+//   q = sign ? -q : q
+// The quotient is computed for |d| and negated at the end. Powers of two
+// (including 1 and MIN) use magic 0 with the add mask set, so q starts as n
+// and bias = |d| - 1 rounds the shift toward zero. Every other |d|, large
+// ones included, uses get_signed_magic(|d|) with bias = 2^shift, which is
+// the usual +1 after the shift for negative quotients.
+// MIN / -1 wraps to MIN, the same as Divider<T>.
+template <typename SIntType> class BranchfreeDivider {
+  static_assert(std::is_signed<SIntType>::value, "SIntType must be signed");
+
+  using UIntType = typename std::make_unsigned<SIntType>::type;
+  static constexpr unsigned B = sizeof(SIntType) * 8;
+
+public:
+  explicit BranchfreeDivider(SIntType divisor) : divisor_(divisor), sign_(divisor < 0 ? static_cast<UIntType>(-1) : 0U) {
+    assert(divisor != 0 && "Divisor must not be 0");
+
+    UIntType const abs_divisor = divisor < 0 ? 0U - static_cast<UIntType>(divisor) : static_cast<UIntType>(divisor);
+    if ((abs_divisor & (abs_divisor - 1)) == 0) {
+      add_mask_ = static_cast<UIntType>(-1);
+      bias_ = abs_divisor - 1;
+      shift_ = sizeof(SIntType) == 4 ? ctz(static_cast<uint32_t>(abs_divisor)) : static_cast<unsigned>(ctzll(abs_divisor));
+    } else {
+      auto const dm = get_signed_magic(static_cast<SIntType>(abs_divisor));
+      magic_ = dm.magic;
+      // Magic overflowed into the sign bit: the dividend has to be added back
+      add_mask_ = dm.magic < 0 ? static_cast<UIntType>(-1) : 0U;
+      bias_ = static_cast<UIntType>(UIntType(1) << dm.shift);
+      shift_ = dm.shift;
+    }
+  }
+
+  SIntType divide(SIntType dividend) const {
+    UIntType q = static_cast<UIntType>(smulh(dividend, magic_)) + (static_cast<UIntType>(dividend) & add_mask_);
+    q += static_cast<UIntType>(static_cast<SIntType>(q) >> (B - 1)) & bias_;
+    q = static_cast<UIntType>(static_cast<SIntType>(q) >> shift_);
+    return static_cast<SIntType>((q ^ sign_) - sign_);
+  }
+
+  SIntType remainder(SIntType dividend) const {
+    UIntType const quotient = static_cast<UIntType>(divide(dividend));
+    return static_cast<SIntType>(static_cast<UIntType>(dividend) - static_cast<UIntType>(divisor_) * quotient);
+  }
+
+  DivMod<SIntType> divmod(SIntType dividend) const {
+    SIntType const quotient = divide(dividend);
+    return {quotient, static_cast<SIntType>(static_cast<UIntType>(dividend) - static_cast<UIntType>(divisor_) * static_cast<UIntType>(quotient))};
+  }
+
+  SIntType divisor() const {
+    return divisor_;
+  }
+  SIntType magic() const {
+    return magic_;
+  }
+  unsigned shift() const {
+    return shift_;
+  }
+
+private:
+  SIntType divisor_;
+  UIntType sign_;
+  SIntType magic_ = 0;
+  UIntType add_mask_ = 0;
+  UIntType bias_ = 0;
+  unsigned shift_ = 0;
+};
+
+// =============================================================================
+// Floor, ceiling and Euclidean division
+// =============================================================================
+
+// All ones if n < 0, else 0
+template <typename SIntType> typename std::make_unsigned<SIntType>::type negative_mask(SIntType n) {
+  return static_cast<typename std::make_unsigned<SIntType>::type>(n >> (sizeof(SIntType) * 8 - 1));
+}
+
+// All ones if n > 0, else 0: -n and ~n are both negative only then, MIN included
+template <typename SIntType> typename std::make_unsigned<SIntType>::type positive_mask(SIntType n) {
+  using UIntType = typename std::make_unsigned<SIntType>::type;
+  UIntType const u = static_cast<UIntType>(n);
+  return negative_mask(static_cast<SIntType>((0U - u) & ~u));
+}
+
+// Signed division rounded toward -infinity (floor), toward +infinity (ceil),
+// or so the remainder is never negative (Euclid). Instead of fixing up a
+// truncating quotient with a remainder compare, the rounding is folded into
+// one unsigned magic divide of |n| by |d|. When the rounding direction is
+// away from zero, the mask m is all ones and |n| - 1 is divided instead:
+//   floor(n / d) = ((|n| + m) / |d|) ^ m,     m set when the quotient is negative
+//   ceil(n / d)  = -(((|n| + m) / |d|) ^ m),  m set when the quotient is positive
+// Euclidean division is floor for d > 0 and ceil for d < 0, which makes m
+// the sign of n in both cases. MIN / -1 wraps to MIN.
+template <typename SIntType> class RoundingDivider {
+  static_assert(std::is_signed<SIntType>::value, "SIntType must be signed");
+
+  using UIntType = typename std::make_unsigned<SIntType>::type;
+
+public:
+  explicit RoundingDivider(SIntType divisor)
+      : divisor_(divisor), sign_(negative_mask(divisor)),
+        magnitude_(divisor < 0 ? 0U - static_cast<UIntType>(divisor) : static_cast<UIntType>(divisor)) {
+  }
+
+  SIntType div_floor(SIntType dividend) const {
+    UIntType const mask = (positive_mask(dividend) & sign_) | (negative_mask(dividend) & ~sign_);
+    return static_cast<SIntType>(magnitude_.divide(abs_dividend(dividend) + mask) ^ mask);
+  }
+
+  SIntType div_ceil(SIntType dividend) const {
+    UIntType const mask = (negative_mask(dividend) & sign_) | (positive_mask(dividend) & ~sign_);
+    return static_cast<SIntType>(0U - (magnitude_.divide(abs_dividend(dividend) + mask) ^ mask));
+  }
+
+  SIntType div_euclid(SIntType dividend) const {
+    UIntType const mask = negative_mask(dividend);
+    UIntType const q = magnitude_.divide(abs_dividend(dividend) + mask) ^ mask;
+    return static_cast<SIntType>((q ^ sign_) - sign_);
+  }
+
+  // Takes the divisor's sign, or is 0
+  SIntType rem_floor(SIntType dividend) const {
+    return static_cast<SIntType>(static_cast<UIntType>(dividend) - static_cast<UIntType>(divisor_) * static_cast<UIntType>(div_floor(dividend)));
+  }
+
+  // Never negative
+  SIntType rem_euclid(SIntType dividend) const {
+    return static_cast<SIntType>(static_cast<UIntType>(dividend) - static_cast<UIntType>(divisor_) * static_cast<UIntType>(div_euclid(dividend)));
+  }
+
+  SIntType divisor() const {
+    return divisor_;
+  }
+
+private:
+  static UIntType abs_dividend(SIntType dividend) {
+    return (static_cast<UIntType>(dividend) ^ negative_mask(dividend)) - negative_mask(dividend);
+  }
+
+  SIntType divisor_;
+  UIntType sign_;
+  Divider<UIntType> magnitude_; // |d|, at most 2^(B-1), so Pow2Shift, MulShift or MulAddShift
+};
+
+// =============================================================================
+// Compile-time constant divider
+// =============================================================================
+
+// Divider for a divisor known at compile time. The magic number and the
+// strategy are constant expressions, so divide() is straight-line code:
+// the same sequence the compiler emits for a literal divisor.
+template <typename IntType, IntType D, bool = std::is_signed<IntType>::value> struct ConstDivider;
+
+template <typename UIntType, UIntType D> struct ConstDivider<UIntType, D, false> {
+  static_assert(D != 0, "Divisor must not be 0");
+
+  static constexpr DivStrategy strategy = (D & (D - 1)) == 0                     ? DivStrategy::Pow2Shift
+                                          : D > (static_cast<UIntType>(-1) >> 1) ? DivStrategy::LargeDivisor
+                                          : get_unsigned_magic(D).is_add         ? DivStrategy::MulAddShift
+                                                                                 : DivStrategy::MulShift;
+
+  static constexpr UnsignedDivMagic<UIntType> dm =
+      strategy == DivStrategy::MulShift || strategy == DivStrategy::MulAddShift
+          ? get_unsigned_magic(D)
+          : UnsignedDivMagic<UIntType>{0, strategy == DivStrategy::Pow2Shift ? trailing_zeros(D) : 0U, false};
+
+  static UIntType divide(UIntType dividend) {
+    if constexpr (strategy == DivStrategy::Pow2Shift) {
+      return dividend >> dm.shift;
+    } else if constexpr (strategy == DivStrategy::LargeDivisor) {
+      return dividend >= D ? 1 : 0;
+    } else if constexpr (strategy == DivStrategy::MulAddShift) {
+      UIntType const high = umulh(dividend, dm.magic);
+      return (high + ((dividend - high) >> 1)) >> dm.shift;
+    } else {
+      return umulh(dividend, dm.magic) >> dm.shift;
+    }
+  }
+
+  static UIntType remainder(UIntType dividend) {
+    return dividend - D * divide(dividend);
+  }
+
+  static DivMod<UIntType> divmod(UIntType dividend) {
+    UIntType const quotient = divide(dividend);
+    return {quotient, static_cast<UIntType>(dividend - D * quotient)};
+  }
+
+  static constexpr DivisibilityMagic<UIntType> dv = get_unsigned_divisibility_magic(D);
+
+  static bool is_divisible(UIntType dividend) {
+    return rotate_right(static_cast<UIntType>(dividend * dv.inverse), dv.shift) <= dv.limit;
+  }
+};
+
+template <typename SIntType, SIntType D> struct ConstDivider<SIntType, D, true> {
+  static_assert(D != 0, "Divisor must not be 0");
+
+  using UIntType = typename std::make_unsigned<SIntType>::type;
+  static constexpr unsigned B = sizeof(SIntType) * 8;
+  static constexpr UIntType abs_divisor = D < 0 ? 0U - static_cast<UIntType>(D) : static_cast<UIntType>(D);
+
+  static constexpr bool needs_add(SignedDivMagic<SIntType> dm) {
+    return (D > 0 && dm.magic < 0) || (D < 0 && dm.magic > 0);
+  }
+
+  static constexpr DivStrategy strategy = (abs_divisor & (abs_divisor - 1)) == 0                ? DivStrategy::Pow2Shift
+                                          : abs_divisor > (static_cast<UIntType>(-1) >> 2)      ? DivStrategy::LargeDivisor
+                                          : needs_add(get_signed_magic(D))                      ? DivStrategy::MulAddShift
+                                                                                                : DivStrategy::MulShift;
+
+  static constexpr SignedDivMagic<SIntType> dm =
+      strategy == DivStrategy::MulShift || strategy == DivStrategy::MulAddShift
+          ? get_signed_magic(D)
+          : SignedDivMagic<SIntType>{0, strategy == DivStrategy::Pow2Shift ? trailing_zeros(abs_divisor) : 0U};
+
+  static SIntType divide(SIntType dividend) {
+    UIntType q;
+    if constexpr (strategy == DivStrategy::Pow2Shift) {
+      SIntType const sign_correction = (dividend >> (B - 1)) & static_cast<SIntType>(abs_divisor - 1);
+      q = static_cast<UIntType>(static_cast<SIntType>(static_cast<UIntType>(dividend) + static_cast<UIntType>(sign_correction)) >> dm.shift);
+    } else if constexpr (strategy == DivStrategy::LargeDivisor) {
+      UIntType const u_dividend = static_cast<UIntType>(dividend);
+      UIntType const u_abs_dividend = dividend < 0 ? 0U - u_dividend : u_dividend;
+      // The sign of the quotient follows the dividend; D's sign is applied below
+      UIntType const dividend_sign = static_cast<UIntType>(dividend >> (B - 1));
+      q = ((u_abs_dividend >= abs_divisor ? 1U : 0U) ^ dividend_sign) - dividend_sign;
+    } else {
+      q = static_cast<UIntType>(smulh(dividend, dm.magic));
+      if constexpr (strategy == DivStrategy::MulAddShift) {
+        if constexpr (D > 0) {
+          q += static_cast<UIntType>(dividend);
+        } else {
+          q -= static_cast<UIntType>(dividend);
+        }
+      }
+      SIntType const shifted = static_cast<SIntType>(q) >> dm.shift;
+      return static_cast<SIntType>(static_cast<UIntType>(shifted) + (static_cast<UIntType>(shifted) >> (B - 1)));
+    }
+    if constexpr (D < 0) {
+      q = 0U - q;
+    }
+    return static_cast<SIntType>(q);
+  }
+
+  static SIntType remainder(SIntType dividend) {
+    UIntType const quotient = static_cast<UIntType>(divide(dividend));
+    return static_cast<SIntType>(static_cast<UIntType>(dividend) - static_cast<UIntType>(D) * quotient);
+  }
+
+  static DivMod<SIntType> divmod(SIntType dividend) {
+    SIntType const quotient = divide(dividend);
+    return {quotient, static_cast<SIntType>(static_cast<UIntType>(dividend) - static_cast<UIntType>(D) * static_cast<UIntType>(quotient))};
+  }
+
+  static constexpr DivisibilityMagic<UIntType> dv = get_signed_divisibility_magic(D);
+
+  static bool is_divisible(SIntType dividend) {
+    return rotate_right(static_cast<UIntType>(static_cast<UIntType>(dividend) * dv.inverse + dv.bias), dv.shift) <= dv.limit;
+  }
+};
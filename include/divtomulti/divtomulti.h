@@ -0,0 +1,26 @@
+#pragma once
+
+// Everything: include this, or just the pieces a translation unit needs
+#include "intrinsics.h"
+#include "magic.h"
+#include "divider.h"
+#include "fastmod.h"
+#include "wide.h"
+#include "cpu.h"
+#include "stats.h"
+#include "batch.h"
+#include "dispatch.h"
+#include "cache.h"
+#include "fpdiv.h"
+#include "u32div.h"
+#include "i32div.h"
+#include "u64div.h"
+#include "i64div.h"
+#include "u128div.h"
+#include "i128div.h"
+#include "decimal.h"
+#include "radix.h"
+#include "modular.h"
+#include "jit.h"
+#include "progression.h"
+#include "proof.h"
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include "intrinsics.h"
+
+// =============================================================================
+// Direct remainder (fastmod)
+// =============================================================================
+
+// Remainder computed straight from a fractional magic instead of
+// dividend - divisor * quotient (Lemire, Kaser, Kurz: "Faster Remainder by
+// Direct Computation"). With M = ceil(2^(2B) / d), the low 2B bits of
+// M * n hold the fractional part of n / d, and multiplying that fraction
+// by d gives n % d in the high B bits.
+template <typename IntType> class FastMod;
+
+template <> class FastMod<uint32_t> {
+public:
+  explicit FastMod(uint32_t divisor) : divisor_(divisor), magic_(static_cast<uint64_t>(-1) / divisor + 1) {
+    assert(divisor != 0 && "Divisor must not be 0");
+  }
+
+  uint32_t remainder(uint32_t dividend) const {
+    uint64_t const fraction = magic_ * dividend;
+    return static_cast<uint32_t>(umulh(fraction, static_cast<uint64_t>(divisor_)));
+  }
+
+  uint32_t divisor() const {
+    return divisor_;
+  }
+  uint64_t magic() const {
+    return magic_;
+  }
+
+private:
+  uint32_t divisor_;
+  uint64_t magic_;
+};
+
+template <> class FastMod<uint64_t> {
+public:
+  explicit FastMod(uint64_t divisor) : divisor_(divisor), magic_(~static_cast<uint128>(0) / divisor + 1) {
+    assert(divisor != 0 && "Divisor must not be 0");
+  }
+
+  uint64_t remainder(uint64_t dividend) const {
+    uint128 const fraction = magic_ * dividend;
+    // High 64 bits of the 192-bit product fraction * divisor
+    uint64_t const lo = static_cast<uint64_t>(fraction);
+    uint64_t const hi = static_cast<uint64_t>(fraction >> 64);
+    return static_cast<uint64_t>((static_cast<uint128>(hi) * divisor_ + umulh(lo, divisor_)) >> 64);
+  }
+
+  uint64_t divisor() const {
+    return divisor_;
+  }
+  uint128 magic() const {
+    return magic_;
+  }
+
+private:
+  uint64_t divisor_;
+  uint128 magic_;
+};
+
+// Signed variants work on |d|; powers of two need the magic rounded up by one,
+// and negative dividends are corrected by |d| - 1 so the result keeps the
+// dividend's sign like the built-in operator.
+template <> class FastMod<int32_t> {
+public:
+  explicit FastMod(int32_t divisor)
+      : divisor_(divisor), abs_divisor_(divisor < 0 ? 0U - static_cast<uint32_t>(divisor) : static_cast<uint32_t>(divisor)),
+        magic_(static_cast<uint64_t>(-1) / abs_divisor_ + 1 + ((abs_divisor_ & (abs_divisor_ - 1)) == 0 ? 1 : 0)) {
+    assert(divisor != 0 && "Divisor must not be 0");
+  }
+
+  int32_t remainder(int32_t dividend) const {
+    uint64_t const fraction = magic_ * static_cast<uint64_t>(static_cast<int64_t>(dividend));
+    int32_t const high = static_cast<int32_t>(umulh(fraction, static_cast<uint64_t>(abs_divisor_)));
+    return high - static_cast<int32_t>((abs_divisor_ - 1) & static_cast<uint32_t>(dividend >> 31));
+  }
+
+  int32_t divisor() const {
+    return divisor_;
+  }
+  uint64_t magic() const {
+    return magic_;
+  }
+
+private:
+  int32_t divisor_;
+  uint32_t abs_divisor_;
+  uint64_t magic_;
+};
+
+template <> class FastMod<int64_t> {
+public:
+  explicit FastMod(int64_t divisor)
+      : divisor_(divisor), abs_divisor_(divisor < 0 ? 0U - static_cast<uint64_t>(divisor) : static_cast<uint64_t>(divisor)),
+        magic_(~static_cast<uint128>(0) / abs_divisor_ + 1 + ((abs_divisor_ & (abs_divisor_ - 1)) == 0 ? 1 : 0)) {
+    assert(divisor != 0 && "Divisor must not be 0");
+  }
+
+  int64_t remainder(int64_t dividend) const {
+    // magic * dividend with the dividend sign-extended to 128 bits
+    uint128 fraction = magic_ * static_cast<uint64_t>(dividend);
+    if (dividend < 0) {
+      fraction -= magic_ << 64;
+    }
+    uint64_t const lo = static_cast<uint64_t>(fraction);
+    uint64_t const hi = static_cast<uint64_t>(fraction >> 64);
+    int64_t const high = static_cast<int64_t>(static_cast<uint64_t>((static_cast<uint128>(hi) * abs_divisor_ + umulh(lo, abs_divisor_)) >> 64));
+    return high - static_cast<int64_t>((abs_divisor_ - 1) & static_cast<uint64_t>(dividend >> 63));
+  }
+
+  int64_t divisor() const {
+    return divisor_;
+  }
+  uint128 magic() const {
+    return magic_;
+  }
+
+private:
+  int64_t divisor_;
+  uint64_t abs_divisor_;
+  uint128 magic_;
+};
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "intrinsics.h"
+
+// =============================================================================
+// Floating-point reciprocal division (32-bit)
+// =============================================================================
+
+// A second division backend that runs on the floating-point units, so it can
+// be interleaved with the integer kernels when the integer multiplier is the
+// bottleneck. Every 32-bit operand is exact in a double. With the reciprocal
+// rounded away from zero, |n * r| is never below |n / d|, and it stays below
+// the next integer because the error, at most |n / d| * 2^-51, is smaller than
+// the gap 1 / |d| for |n| < 2^51. So truncating n * r gives the quotient with
+// no correction step. The FMA residual r * d - 1 is how the constructor
+// decides the rounding direction, and the batch remainder is a single fused
+// n - q * d, exact because q * d < 2^53.
+template <typename IntType> class FloatDivider {
+  static_assert(std::is_integral<IntType>::value && sizeof(IntType) == 4, "FloatDivider supports 32-bit integers");
+
+public:
+  explicit FloatDivider(IntType divisor) : divisor_(divisor) {
+    assert(divisor != 0 && "Divisor must not be 0");
+    double const d = static_cast<double>(divisor);
+    reciprocal_ = 1.0 / d;
+    // r * d - 1 < 0 means |r| < 1 / |d|: step one ulp away from zero
+    if (std::fma(reciprocal_, d, -1.0) < 0) {
+      reciprocal_ = std::nextafter(reciprocal_, divisor > 0 ? 2.0 : -2.0);
+    }
+  }
+
+  // INT32_MIN / -1 wraps to INT32_MIN, the same as Divider<int32_t>
+  IntType divide(IntType dividend) const {
+    int64_t const q = static_cast<int64_t>(static_cast<double>(dividend) * reciprocal_);
+    return static_cast<IntType>(static_cast<uint32_t>(q));
+  }
+
+  IntType remainder(IntType dividend) const {
+    return static_cast<IntType>(static_cast<uint32_t>(dividend) - static_cast<uint32_t>(divisor_) * static_cast<uint32_t>(divide(dividend)));
+  }
+
+  IntType divisor() const {
+    return divisor_;
+  }
+  double reciprocal() const {
+    return reciprocal_;
+  }
+
+private:
+  IntType divisor_;
+  double reciprocal_;
+};
+
+// Batch kernels, bound once per dispatch tier like the Divider<T> ones (see
+// dispatch.h): 4 doubles per vector with AVX2 and FMA, scalar otherwise
+namespace fpdiv {
+namespace scalar {
+
+template <typename IntType> void divide(const IntType *in, IntType *out, size_t n, FloatDivider<IntType> const &divider) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = divider.divide(in[i]);
+  }
+}
+
+template <typename IntType> void remainder(const IntType *in, IntType *out, size_t n, FloatDivider<IntType> const &divider) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = divider.remainder(in[i]);
+  }
+}
+
+} // namespace scalar
+
+#ifdef DIVTOMULTI_X86
+namespace avx2 {
+
+// Unsigned lanes go through the signed conversions with a 2^31 bias: the xor
+// flips the top bit, and subtracting 2^31 after the conversion is exact
+inline DIVTOMULTI_TARGET("avx2,fma") __m256d load_u32(const uint32_t *in) {
+  __m128i const flipped = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), _mm_set1_epi32(INT32_MIN));
+  return _mm256_add_pd(_mm256_cvtepi32_pd(flipped), _mm256_set1_pd(2147483648.0));
+}
+
+// value must be integral and in [0, 2^32)
+inline DIVTOMULTI_TARGET("avx2,fma") void store_u32(uint32_t *out, __m256d value) {
+  __m128i const flipped = _mm256_cvttpd_epi32(_mm256_sub_pd(value, _mm256_set1_pd(2147483648.0)));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_xor_si128(flipped, _mm_set1_epi32(INT32_MIN)));
+}
+
+inline DIVTOMULTI_TARGET("avx2,fma") __m256d load_i32(const int32_t *in) {
+  return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)));
+}
+
+// Out-of-range lanes (INT32_MIN / -1) convert to 0x80000000, which is the wrapped quotient
+inline DIVTOMULTI_TARGET("avx2,fma") void store_i32(int32_t *out, __m256d value) {
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm256_cvttpd_epi32(value));
+}
+
+inline DIVTOMULTI_TARGET("avx2,fma") __m256d load(const uint32_t *in) {
+  return load_u32(in);
+}
+inline DIVTOMULTI_TARGET("avx2,fma") __m256d load(const int32_t *in) {
+  return load_i32(in);
+}
+inline DIVTOMULTI_TARGET("avx2,fma") void store(uint32_t *out, __m256d value) {
+  store_u32(out, value);
+}
+inline DIVTOMULTI_TARGET("avx2,fma") void store(int32_t *out, __m256d value) {
+  store_i32(out, value);
+}
+
+// Two vectors per iteration, so the multiply and convert latencies overlap
+template <typename IntType> DIVTOMULTI_TARGET("avx2,fma") void divide(const IntType *in, IntType *out, size_t n, FloatDivider<IntType> const &divider) {
+  __m256d const r = _mm256_set1_pd(divider.reciprocal());
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256d const q0 = _mm256_round_pd(_mm256_mul_pd(load(in + i), r), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m256d const q1 = _mm256_round_pd(_mm256_mul_pd(load(in + i + 4), r), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    store(out + i, q0);
+    store(out + i + 4, q1);
+  }
+  scalar::divide(in + i, out + i, n - i, divider);
+}
+
+template <typename IntType> DIVTOMULTI_TARGET("avx2,fma") void remainder(const IntType *in, IntType *out, size_t n, FloatDivider<IntType> const &divider) {
+  __m256d const r = _mm256_set1_pd(divider.reciprocal());
+  __m256d const d = _mm256_set1_pd(static_cast<double>(divider.divisor()));
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256d const x0 = load(in + i);
+    __m256d const x1 = load(in + i + 4);
+    __m256d const q0 = _mm256_round_pd(_mm256_mul_pd(x0, r), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m256d const q1 = _mm256_round_pd(_mm256_mul_pd(x1, r), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    store(out + i, _mm256_fnmadd_pd(q0, d, x0)); // x - q * d
+    store(out + i + 4, _mm256_fnmadd_pd(q1, d, x1));
+  }
+  scalar::remainder(in + i, out + i, n - i, divider);
+}
+
+} // namespace avx2
+#endif
+
+} // namespace fpdiv
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+#include "intrinsics.h"
+#include "wide.h"
+
+// =============================================================================
+// i128div namespace
+// =============================================================================
+
+namespace i128div {
+
+// Like u128div::opt_cal, a WideDivider per call: slower than normal_cal for
+// a single division; keep a WideDivider<int64_t> for repeated divisors
+inline int128 opt_cal_signed(int128 dividend, int64_t divisor) {
+  return WideDivider<int64_t>(divisor).divide(dividend);
+}
+
+inline int128 normal_cal(int128 dividend, int64_t divisor) {
+  return dividend / divisor;
+}
+
+inline int64_t opt_rem_signed(int128 dividend, int64_t divisor) {
+  return WideDivider<int64_t>(divisor).remainder(dividend);
+}
+
+inline int64_t normal_rem(int128 dividend, int64_t divisor) {
+  return static_cast<int64_t>(dividend % divisor);
+}
+
+} // namespace i128div
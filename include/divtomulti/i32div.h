@@ -0,0 +1,230 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cache.h"
+#include "dispatch.h"
+#include "divider.h"
+#include "fpdiv.h"
+#include "magic.h"
+#include "stats.h"
+#include "u32div.h"
+
+// =============================================================================
+// i32div namespace
+// =============================================================================
+
+namespace i32div {
+
+// 32-bit signed division using smull-style: 32x32->64 signed multiply
+inline int32_t opt_cal_signed(int32_t dividend, int32_t divisor) {
+  assert(divisor != 0);
+
+  // Handle special case: INT32_MIN / -1 would overflow
+  if (dividend == INT32_MIN && divisor == -1) {
+    DIVTOMULTI_STATS_COUNT(Overflow, divisor);
+    return INT32_MIN;
+  }
+
+  if (divisor == 1) {
+    DIVTOMULTI_STATS_COUNT(One, divisor);
+    return dividend;
+  }
+
+  if (divisor == -1) {
+    DIVTOMULTI_STATS_COUNT(MinusOne, divisor);
+    return -dividend;
+  }
+
+  int32_t const abs_divisor = divisor < 0 ? -divisor : divisor;
+
+  // Check if divisor is power of 2
+  if ((abs_divisor & (abs_divisor - 1)) == 0) {
+    DIVTOMULTI_STATS_COUNT(Pow2, divisor);
+    uint32_t const shift = ctz(static_cast<uint32_t>(abs_divisor));
+    int32_t const sign_correction = (dividend >> 31) & (abs_divisor - 1);
+    int32_t q = (dividend + sign_correction) >> shift;
+    if (divisor < 0) {
+      q = -q;
+    }
+    return q;
+  }
+
+  // For large divisors (absolute value > INT32_MAX/2), quotient is -1, 0, or 1
+  if (abs_divisor > (INT32_MAX >> 1)) {
+    DIVTOMULTI_STATS_COUNT(Large, divisor);
+    uint32_t const u_dividend = static_cast<uint32_t>(dividend);
+    uint32_t const u_abs_dividend = dividend < 0 ? -u_dividend : u_dividend;
+    uint32_t const u_abs_divisor = static_cast<uint32_t>(abs_divisor);
+
+    bool const same_sign = (dividend >= 0) == (divisor >= 0);
+    if (u_abs_dividend >= u_abs_divisor) {
+      return same_sign ? 1 : -1;
+    }
+    return 0;
+  }
+
+  auto const dm = get_signed_magic(divisor);
+
+  // smull: 32x32 -> 64 signed multiply, take high 32 bits
+  int64_t const product = static_cast<int64_t>(dividend) * dm.magic;
+  int32_t q = static_cast<int32_t>(product >> 32);
+
+  // Correction for magic overflow
+  if (divisor > 0 && dm.magic < 0) {
+    DIVTOMULTI_STATS_COUNT(MulAddShift, divisor);
+    q += dividend;
+  } else if (divisor < 0 && dm.magic > 0) {
+    DIVTOMULTI_STATS_COUNT(MulAddShift, divisor);
+    q -= dividend;
+  } else {
+    DIVTOMULTI_STATS_COUNT(MulShift, divisor);
+  }
+  if (dm.magic < 0) {
+    DIVTOMULTI_STATS_COUNT(NegativeMagic, divisor);
+  }
+
+  // Arithmetic shift right
+  q >>= dm.shift;
+
+  // Round toward zero correction
+  q += static_cast<uint32_t>(q) >> 31;
+
+  return q;
+}
+
+inline int32_t normal_cal(int32_t dividend, int32_t divisor) {
+  return dividend / divisor;
+}
+
+inline int32_t opt_rem_signed(int32_t dividend, int32_t divisor) {
+  int32_t quotient = opt_cal_signed(dividend, divisor);
+  return dividend - divisor * quotient;
+}
+
+inline int32_t normal_rem(int32_t dividend, int32_t divisor) {
+  return dividend % divisor;
+}
+
+// opt_cal_signed with the magic number looked up in (or added to) a DividerCache,
+// for runtime divisors that repeat
+inline int32_t opt_cal_signed_cached(int32_t dividend, int32_t divisor, DividerCache<int32_t> &cache = default_divider_cache<int32_t>()) {
+  return cache.get(divisor).divide(dividend);
+}
+
+inline int32_t opt_rem_signed_cached(int32_t dividend, int32_t divisor, DividerCache<int32_t> &cache = default_divider_cache<int32_t>()) {
+  return cache.get(divisor).remainder(dividend);
+}
+
+inline void divide(const int32_t *in, int32_t *out, size_t n, Divider<int32_t> const &divider) {
+  dispatch().i32.divide_batch(in, out, n, divider);
+}
+
+inline void divide(const int32_t *in, int32_t *out, size_t n, int32_t divisor) {
+  divide(in, out, n, Divider<int32_t>(divisor));
+}
+
+inline void remainder(const int32_t *in, int32_t *out, size_t n, Divider<int32_t> const &divider) {
+  dispatch().i32.remainder_batch(in, out, n, divider);
+}
+
+inline void remainder(const int32_t *in, int32_t *out, size_t n, int32_t divisor) {
+  remainder(in, out, n, Divider<int32_t>(divisor));
+}
+
+// Batch forms on the floating-point units, to run beside the integer kernels
+inline void divide(const int32_t *in, int32_t *out, size_t n, FloatDivider<int32_t> const &divider) {
+  dispatch().float_i32.divide_batch(in, out, n, divider);
+}
+
+inline void remainder(const int32_t *in, int32_t *out, size_t n, FloatDivider<int32_t> const &divider) {
+  dispatch().float_i32.remainder_batch(in, out, n, divider);
+}
+
+// Quotient and remainder from one multiply-high; opt_rem_signed would recompute the quotient
+inline DivMod<int32_t> divmod(int32_t dividend, int32_t divisor) {
+  int32_t const quotient = opt_cal_signed(dividend, divisor);
+  return {quotient, static_cast<int32_t>(static_cast<uint32_t>(dividend) - static_cast<uint32_t>(divisor) * static_cast<uint32_t>(quotient))};
+}
+
+inline DivMod<int32_t> divmod(int32_t dividend, Divider<int32_t> const &divider) {
+  return divider.divmod(dividend);
+}
+
+inline void divmod(const int32_t *in, int32_t *quotient, int32_t *remainder, size_t n, Divider<int32_t> const &divider) {
+  dispatch().i32.divmod_batch(in, quotient, remainder, n, divider);
+}
+
+inline void divmod(const int32_t *in, int32_t *quotient, int32_t *remainder, size_t n, int32_t divisor) {
+  divmod(in, quotient, remainder, n, Divider<int32_t>(divisor));
+}
+
+// dividend % divisor == 0 via the inverse of the divisor's odd part and a rotate
+inline bool is_divisible(int32_t dividend, int32_t divisor) {
+  auto const dm = get_signed_divisibility_magic(divisor);
+  uint32_t const x = static_cast<uint32_t>(static_cast<uint32_t>(dividend) * dm.inverse + dm.bias);
+  return rotate_right(x, dm.shift) <= dm.limit;
+}
+
+inline bool is_divisible(int32_t dividend, DivisibilityTester<int32_t> const &tester) {
+  return tester.is_divisible(dividend);
+}
+
+// Floor, ceiling and Euclidean division: one unsigned magic divide of |dividend|
+// by |divisor|, with the rounding folded in (see RoundingDivider)
+inline uint32_t unsigned_abs(int32_t value) {
+  return value < 0 ? 0U - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+}
+
+inline int32_t div_floor(int32_t dividend, int32_t divisor) {
+  assert(divisor != 0);
+  uint32_t const sign = negative_mask(divisor);
+  uint32_t const mask = (positive_mask(dividend) & sign) | (negative_mask(dividend) & ~sign);
+  return static_cast<int32_t>(u32div::opt_cal(unsigned_abs(dividend) + mask, unsigned_abs(divisor)) ^ mask);
+}
+
+inline int32_t div_ceil(int32_t dividend, int32_t divisor) {
+  assert(divisor != 0);
+  uint32_t const sign = negative_mask(divisor);
+  uint32_t const mask = (negative_mask(dividend) & sign) | (positive_mask(dividend) & ~sign);
+  return static_cast<int32_t>(0U - (u32div::opt_cal(unsigned_abs(dividend) + mask, unsigned_abs(divisor)) ^ mask));
+}
+
+inline int32_t div_euclid(int32_t dividend, int32_t divisor) {
+  assert(divisor != 0);
+  uint32_t const sign = negative_mask(divisor);
+  uint32_t const mask = negative_mask(dividend);
+  uint32_t const q = u32div::opt_cal(unsigned_abs(dividend) + mask, unsigned_abs(divisor)) ^ mask;
+  return static_cast<int32_t>((q ^ sign) - sign);
+}
+
+inline int32_t rem_floor(int32_t dividend, int32_t divisor) {
+  return static_cast<int32_t>(static_cast<uint32_t>(dividend) - static_cast<uint32_t>(divisor) * static_cast<uint32_t>(div_floor(dividend, divisor)));
+}
+
+inline int32_t rem_euclid(int32_t dividend, int32_t divisor) {
+  return static_cast<int32_t>(static_cast<uint32_t>(dividend) - static_cast<uint32_t>(divisor) * static_cast<uint32_t>(div_euclid(dividend, divisor)));
+}
+
+inline int32_t div_floor(int32_t dividend, RoundingDivider<int32_t> const &divider) {
+  return divider.div_floor(dividend);
+}
+
+inline int32_t div_ceil(int32_t dividend, RoundingDivider<int32_t> const &divider) {
+  return divider.div_ceil(dividend);
+}
+
+inline int32_t div_euclid(int32_t dividend, RoundingDivider<int32_t> const &divider) {
+  return divider.div_euclid(dividend);
+}
+
+inline int32_t rem_floor(int32_t dividend, RoundingDivider<int32_t> const &divider) {
+  return divider.rem_floor(dividend);
+}
+
+inline int32_t rem_euclid(int32_t dividend, RoundingDivider<int32_t> const &divider) {
+  return divider.rem_euclid(dividend);
+}
+
+} // namespace i32div
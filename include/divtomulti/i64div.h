@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cache.h"
+#include "dispatch.h"
+#include "divider.h"
+#include "magic.h"
+#include "stats.h"
+#include "u64div.h"
+
+// =============================================================================
+// i64div namespace
+// =============================================================================
+
+namespace i64div {
+
+inline int64_t opt_cal_signed(int64_t dividend, int64_t divisor) {
+  assert(divisor != 0);
+
+  // Handle special case: INT64_MIN / -1 would overflow
+  if (dividend == INT64_MIN && divisor == -1) {
+    DIVTOMULTI_STATS_COUNT(Overflow, divisor);
+    return INT64_MIN;
+  }
+
+  if (divisor == 1) {
+    DIVTOMULTI_STATS_COUNT(One, divisor);
+    return dividend;
+  }
+
+  if (divisor == -1) {
+    DIVTOMULTI_STATS_COUNT(MinusOne, divisor);
+    return -dividend;
+  }
+
+  int64_t const abs_divisor = divisor < 0 ? -divisor : divisor;
+
+  // Check if divisor is power of 2
+  if ((abs_divisor & (abs_divisor - 1)) == 0) {
+    DIVTOMULTI_STATS_COUNT(Pow2, divisor);
+    uint64_t const shift = ctzll(static_cast<uint64_t>(abs_divisor));
+    int64_t const sign_correction = (dividend >> 63) & (abs_divisor - 1);
+    int64_t q = (dividend + sign_correction) >> shift;
+    if (divisor < 0) {
+      q = -q;
+    }
+    return q;
+  }
+
+  // For large divisors (absolute value > INT64_MAX/2), quotient is -1, 0, or 1
+  if (abs_divisor > (INT64_MAX >> 1)) {
+    DIVTOMULTI_STATS_COUNT(Large, divisor);
+    uint64_t const u_dividend = static_cast<uint64_t>(dividend);
+    uint64_t const u_abs_dividend = dividend < 0 ? -u_dividend : u_dividend;
+    uint64_t const u_abs_divisor = static_cast<uint64_t>(abs_divisor);
+
+    bool const same_sign = (dividend >= 0) == (divisor >= 0);
+    if (u_abs_dividend >= u_abs_divisor) {
+      return same_sign ? 1 : -1;
+    }
+    return 0;
+  }
+
+  auto const dm = get_signed_magic(divisor);
+
+  // q = smulh(dividend, magic)
+  int64_t q = smulh(dividend, dm.magic);
+
+  // If magic is negative (for positive divisor), add dividend
+  // If magic is positive (for negative divisor), subtract dividend
+  if (divisor > 0 && dm.magic < 0) {
+    DIVTOMULTI_STATS_COUNT(MulAddShift, divisor);
+    q += dividend;
+  } else if (divisor < 0 && dm.magic > 0) {
+    DIVTOMULTI_STATS_COUNT(MulAddShift, divisor);
+    q -= dividend;
+  } else {
+    DIVTOMULTI_STATS_COUNT(MulShift, divisor);
+  }
+  if (dm.magic < 0) {
+    DIVTOMULTI_STATS_COUNT(NegativeMagic, divisor);
+  }
+
+  // Arithmetic shift right
+  q >>= dm.shift;
+
+  // Round toward zero correction
+  q += static_cast<uint64_t>(q) >> 63;
+
+  return q;
+}
+
+inline int64_t normal_cal(int64_t dividend, int64_t divisor) {
+  return dividend / divisor;
+}
+
+inline int64_t opt_rem_signed(int64_t dividend, int64_t divisor) {
+  int64_t quotient = opt_cal_signed(dividend, divisor);
+  return dividend - divisor * quotient;
+}
+
+inline int64_t normal_rem(int64_t dividend, int64_t divisor) {
+  return dividend % divisor;
+}
+
+// opt_cal_signed with the magic number looked up in (or added to) a DividerCache,
+// for runtime divisors that repeat
+inline int64_t opt_cal_signed_cached(int64_t dividend, int64_t divisor, DividerCache<int64_t> &cache = default_divider_cache<int64_t>()) {
+  return cache.get(divisor).divide(dividend);
+}
+
+inline int64_t opt_rem_signed_cached(int64_t dividend, int64_t divisor, DividerCache<int64_t> &cache = default_divider_cache<int64_t>()) {
+  return cache.get(divisor).remainder(dividend);
+}
+
+inline void divide(const int64_t *in, int64_t *out, size_t n, Divider<int64_t> const &divider) {
+  dispatch().i64.divide_batch(in, out, n, divider);
+}
+
+inline void divide(const int64_t *in, int64_t *out, size_t n, int64_t divisor) {
+  divide(in, out, n, Divider<int64_t>(divisor));
+}
+
+inline void remainder(const int64_t *in, int64_t *out, size_t n, Divider<int64_t> const &divider) {
+  dispatch().i64.remainder_batch(in, out, n, divider);
+}
+
+inline void remainder(const int64_t *in, int64_t *out, size_t n, int64_t divisor) {
+  remainder(in, out, n, Divider<int64_t>(divisor));
+}
+
+// Quotient and remainder from one multiply-high; opt_rem_signed would recompute the quotient
+inline DivMod<int64_t> divmod(int64_t dividend, int64_t divisor) {
+  int64_t const quotient = opt_cal_signed(dividend, divisor);
+  return {quotient, static_cast<int64_t>(static_cast<uint64_t>(dividend) - static_cast<uint64_t>(divisor) * static_cast<uint64_t>(quotient))};
+}
+
+inline DivMod<int64_t> divmod(int64_t dividend, Divider<int64_t> const &divider) {
+  return divider.divmod(dividend);
+}
+
+inline void divmod(const int64_t *in, int64_t *quotient, int64_t *remainder, size_t n, Divider<int64_t> const &divider) {
+  dispatch().i64.divmod_batch(in, quotient, remainder, n, divider);
+}
+
+inline void divmod(const int64_t *in, int64_t *quotient, int64_t *remainder, size_t n, int64_t divisor) {
+  divmod(in, quotient, remainder, n, Divider<int64_t>(divisor));
+}
+
+// dividend % divisor == 0 via the inverse of the divisor's odd part and a rotate
+inline bool is_divisible(int64_t dividend, int64_t divisor) {
+  auto const dm = get_signed_divisibility_magic(divisor);
+  uint64_t const x = static_cast<uint64_t>(static_cast<uint64_t>(dividend) * dm.inverse + dm.bias);
+  return rotate_right(x, dm.shift) <= dm.limit;
+}
+
+inline bool is_divisible(int64_t dividend, DivisibilityTester<int64_t> const &tester) {
+  return tester.is_divisible(dividend);
+}
+
+// Floor, ceiling and Euclidean division: one unsigned magic divide of |dividend|
+// by |divisor|, with the rounding folded in (see RoundingDivider)
+inline uint64_t unsigned_abs(int64_t value) {
+  return value < 0 ? 0U - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+}
+
+inline int64_t div_floor(int64_t dividend, int64_t divisor) {
+  assert(divisor != 0);
+  uint64_t const sign = negative_mask(divisor);
+  uint64_t const mask = (positive_mask(dividend) & sign) | (negative_mask(dividend) & ~sign);
+  return static_cast<int64_t>(u64div::opt_cal(unsigned_abs(dividend) + mask, unsigned_abs(divisor)) ^ mask);
+}
+
+inline int64_t div_ceil(int64_t dividend, int64_t divisor) {
+  assert(divisor != 0);
+  uint64_t const sign = negative_mask(divisor);
+  uint64_t const mask = (negative_mask(dividend) & sign) | (positive_mask(dividend) & ~sign);
+  return static_cast<int64_t>(0U - (u64div::opt_cal(unsigned_abs(dividend) + mask, unsigned_abs(divisor)) ^ mask));
+}
+
+inline int64_t div_euclid(int64_t dividend, int64_t divisor) {
+  assert(divisor != 0);
+  uint64_t const sign = negative_mask(divisor);
+  uint64_t const mask = negative_mask(dividend);
+  uint64_t const q = u64div::opt_cal(unsigned_abs(dividend) + mask, unsigned_abs(divisor)) ^ mask;
+  return static_cast<int64_t>((q ^ sign) - sign);
+}
+
+inline int64_t rem_floor(int64_t dividend, int64_t divisor) {
+  return static_cast<int64_t>(static_cast<uint64_t>(dividend) - static_cast<uint64_t>(divisor) * static_cast<uint64_t>(div_floor(dividend, divisor)));
+}
+
+inline int64_t rem_euclid(int64_t dividend, int64_t divisor) {
+  return static_cast<int64_t>(static_cast<uint64_t>(dividend) - static_cast<uint64_t>(divisor) * static_cast<uint64_t>(div_euclid(dividend, divisor)));
+}
+
+inline int64_t div_floor(int64_t dividend, RoundingDivider<int64_t> const &divider) {
+  return divider.div_floor(dividend);
+}
+
+inline int64_t div_ceil(int64_t dividend, RoundingDivider<int64_t> const &divider) {
+  return divider.div_ceil(dividend);
+}
+
+inline int64_t div_euclid(int64_t dividend, RoundingDivider<int64_t> const &divider) {
+  return divider.div_euclid(dividend);
+}
+
+inline int64_t rem_floor(int64_t dividend, RoundingDivider<int64_t> const &divider) {
+  return divider.rem_floor(dividend);
+}
+
+inline int64_t rem_euclid(int64_t dividend, RoundingDivider<int64_t> const &divider) {
+  return divider.rem_euclid(dividend);
+}
+
+} // namespace i64div
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <__msvc_int128.hpp>
+#include <intrin.h>
+using uint128 = std::_Unsigned128;
+using int128 = std::_Signed128;
+#else
+using uint128 = __uint128_t;
+using int128 = __int128_t;
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DIVTOMULTI_X86 1
+#include <immintrin.h>
+#ifndef _MSC_VER
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DIVTOMULTI_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Per-function ISA selection, so kernels for newer extensions build without global -m flags
+#ifdef _MSC_VER
+#define DIVTOMULTI_TARGET(isa)
+#else
+#define DIVTOMULTI_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+inline uint64_t umulh(uint64_t x, uint64_t y) {
+#ifdef _MSC_VER
+  return __umulh(x, y);
+#else
+  return static_cast<uint64_t>((static_cast<uint128>(x) * y) >> 64ULL);
+#endif
+}
+
+inline uint32_t umulh(uint32_t x, uint32_t y) {
+  return static_cast<uint32_t>((static_cast<uint64_t>(x) * y) >> 32U);
+}
+
+inline int64_t smulh(int64_t x, int64_t y) {
+#ifdef _MSC_VER
+  return __mulh(x, y);
+#else
+  return static_cast<int64_t>((static_cast<int128>(x) * y) >> 64);
+#endif
+}
+
+inline int32_t smulh(int32_t x, int32_t y) {
+  return static_cast<int32_t>((static_cast<int64_t>(x) * y) >> 32);
+}
+
+inline uint64_t clzll(uint64_t x) {
+#ifdef _MSC_VER
+  unsigned long index;
+  if (_BitScanReverse64(&index, x)) {
+    return 63ULL - index;
+  }
+  return 64ULL;
+#else
+  return static_cast<uint64_t>(__builtin_clzll(x));
+#endif
+}
+
+inline uint32_t ctz(uint32_t x) {
+#ifdef _MSC_VER
+  unsigned long index;
+  if (_BitScanForward(&index, x)) {
+    return index;
+  }
+  return 32U;
+#else
+  return static_cast<uint32_t>(__builtin_ctz(x));
+#endif
+}
+
+inline uint64_t ctzll(uint64_t x) {
+#ifdef _MSC_VER
+  unsigned long index;
+  if (_BitScanForward64(&index, x)) {
+    return index;
+  }
+  return 64ULL;
+#else
+  return static_cast<uint64_t>(__builtin_ctzll(x));
+#endif
+}
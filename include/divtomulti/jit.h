@@ -0,0 +1,371 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+#include "dispatch.h"
+#include "divider.h"
+#include "magic.h"
+
+// x86-64 System V with POSIX mmap; everything else takes the fallback
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__)) && !defined(DIVTOMULTI_NO_JIT)
+#define DIVTOMULTI_JIT_X64 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// =============================================================================
+// Per-divisor machine code
+// =============================================================================
+
+// Divider<T> keeps magic and shift in memory and switches on the strategy for
+// every call. JitDivider emits what the compiler emits for a literal divisor
+// (see doc/forDisassembly.cpp): the magic as an immediate, a fixed shift and
+// only the instructions of one strategy. A scalar function and a batch loop
+// are written into one page, mapped writable and then flipped to executable,
+// so the page is never writable and executable at once. When the target has
+// no emitter or the system refuses executable mappings (W^X policies,
+// SELinux execmem), compiled() is false and every call goes to Divider<T>.
+//
+// The scalar function is reached through a pointer, which costs about as much
+// as the strategy switch it removes. The gain is in the batch loop, which beats
+// the scalar and BMI2 kernels but not the AVX2/AVX-512 ones, and in callers
+// that hand function() to code taking a plain function pointer.
+
+namespace jit {
+
+// Straight-line x86-64 code, written byte by byte
+class CodeBuffer {
+public:
+  void emit(std::initializer_list<uint8_t> bytes) {
+    code_.insert(code_.end(), bytes.begin(), bytes.end());
+  }
+  void emit32(uint32_t value) {
+    for (unsigned i = 0; i < 4; ++i) {
+      code_.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+  }
+  void emit64(uint64_t value) {
+    emit32(static_cast<uint32_t>(value));
+    emit32(static_cast<uint32_t>(value >> 32));
+  }
+  // rel32 at offset `at` so the jump lands on `target`
+  void patch_rel32(size_t at, size_t target) {
+    uint32_t const rel = static_cast<uint32_t>(static_cast<int32_t>(target) - static_cast<int32_t>(at + 4));
+    std::memcpy(&code_[at], &rel, sizeof(rel));
+  }
+  void align(size_t boundary) {
+    while (code_.size() % boundary != 0) {
+      code_.push_back(0xCC); // int3
+    }
+  }
+  size_t size() const {
+    return code_.size();
+  }
+  uint8_t const *data() const {
+    return code_.data();
+  }
+
+private:
+  std::vector<uint8_t> code_;
+};
+
+// Bodies take the dividend in edi/rdi and leave the quotient in eax/rax.
+// They clobber rcx and rdx only, so the batch loop keeps its state in r8, r9, rsi.
+
+inline void emit_divide(CodeBuffer &code, Divider<uint32_t> const &divider) {
+  uint32_t const magic = divider.magic();
+  uint8_t const shift = static_cast<uint8_t>(divider.shift());
+  switch (divider.strategy()) {
+  case DivStrategy::Pow2Shift:
+    code.emit({0x89, 0xF8}); // mov eax, edi
+    if (shift != 0) {
+      code.emit({0xC1, 0xE8, shift}); // shr eax, shift
+    }
+    break;
+  case DivStrategy::LargeDivisor:
+    code.emit({0x31, 0xC0}); // xor eax, eax
+    code.emit({0x81, 0xFF}); // cmp edi, divisor
+    code.emit32(divider.divisor());
+    code.emit({0x0F, 0x93, 0xC0}); // setae al
+    break;
+  case DivStrategy::MulShift:
+    code.emit({0x89, 0xF8}); // mov eax, edi
+    code.emit({0xB9});       // mov ecx, magic
+    code.emit32(magic);
+    code.emit({0x48, 0x0F, 0xAF, 0xC1});                  // imul rax, rcx
+    code.emit({0x48, 0xC1, 0xE8, static_cast<uint8_t>(32 + shift)}); // shr rax, 32 + shift
+    break;
+  case DivStrategy::MulAddShift:
+    code.emit({0x89, 0xF8}); // mov eax, edi
+    code.emit({0xB9});       // mov ecx, magic
+    code.emit32(magic);
+    code.emit({0x48, 0x0F, 0xAF, 0xC1}); // imul rax, rcx
+    code.emit({0x48, 0xC1, 0xE8, 0x20}); // shr rax, 32
+    code.emit({0x89, 0xFA});             // mov edx, edi
+    code.emit({0x29, 0xC2});             // sub edx, eax
+    code.emit({0xD1, 0xEA});             // shr edx, 1
+    code.emit({0x01, 0xD0});             // add eax, edx
+    if (shift != 0) {
+      code.emit({0xC1, 0xE8, shift}); // shr eax, shift
+    }
+    break;
+  }
+}
+
+inline void emit_divide(CodeBuffer &code, Divider<uint64_t> const &divider) {
+  uint8_t const shift = static_cast<uint8_t>(divider.shift());
+  switch (divider.strategy()) {
+  case DivStrategy::Pow2Shift:
+    code.emit({0x48, 0x89, 0xF8}); // mov rax, rdi
+    if (shift != 0) {
+      code.emit({0x48, 0xC1, 0xE8, shift}); // shr rax, shift
+    }
+    break;
+  case DivStrategy::LargeDivisor:
+    code.emit({0x31, 0xC0});       // xor eax, eax
+    code.emit({0x48, 0xB9});       // mov rcx, divisor
+    code.emit64(divider.divisor());
+    code.emit({0x48, 0x39, 0xCF}); // cmp rdi, rcx
+    code.emit({0x0F, 0x93, 0xC0}); // setae al
+    break;
+  case DivStrategy::MulShift:
+    code.emit({0x48, 0xB8}); // mov rax, magic
+    code.emit64(divider.magic());
+    code.emit({0x48, 0xF7, 0xE7}); // mul rdi
+    code.emit({0x48, 0x89, 0xD0}); // mov rax, rdx
+    if (shift != 0) {
+      code.emit({0x48, 0xC1, 0xE8, shift}); // shr rax, shift
+    }
+    break;
+  case DivStrategy::MulAddShift:
+    code.emit({0x48, 0xB8}); // mov rax, magic
+    code.emit64(divider.magic());
+    code.emit({0x48, 0xF7, 0xE7}); // mul rdi
+    code.emit({0x48, 0x89, 0xF8}); // mov rax, rdi
+    code.emit({0x48, 0x29, 0xD0}); // sub rax, rdx
+    code.emit({0x48, 0xD1, 0xE8}); // shr rax, 1
+    code.emit({0x48, 0x01, 0xD0}); // add rax, rdx
+    if (shift != 0) {
+      code.emit({0x48, 0xC1, 0xE8, shift}); // shr rax, shift
+    }
+    break;
+  }
+}
+
+// Signed widths only have two shapes: a power of two, or a magic multiply.
+// Large divisors go through get_signed_magic too, which needs no compare.
+template <typename SIntType> struct SignedPlan {
+  bool pow2;
+  bool negative;
+  bool add;   // add (divisor > 0) or subtract (divisor < 0) the dividend after the multiply
+  SIntType magic;
+  uint8_t shift;
+};
+
+template <typename SIntType> SignedPlan<SIntType> plan_signed(Divider<SIntType> const &divider) {
+  SIntType const divisor = divider.divisor();
+  SignedPlan<SIntType> plan{divider.strategy() == DivStrategy::Pow2Shift, divisor < 0, false, divider.magic(), static_cast<uint8_t>(divider.shift())};
+  if (divider.strategy() == DivStrategy::LargeDivisor) {
+    auto const dm = get_signed_magic(divisor);
+    plan.magic = dm.magic;
+    plan.shift = static_cast<uint8_t>(dm.shift);
+    plan.add = (divisor > 0 && dm.magic < 0) || (divisor < 0 && dm.magic > 0);
+  } else {
+    plan.add = divider.strategy() == DivStrategy::MulAddShift;
+  }
+  return plan;
+}
+
+inline void emit_divide(CodeBuffer &code, Divider<int32_t> const &divider) {
+  SignedPlan<int32_t> const plan = plan_signed(divider);
+  if (plan.pow2) {
+    code.emit({0x89, 0xF8}); // mov eax, edi
+    if (plan.shift != 0) {
+      // Round toward zero: add 2^shift - 1 to negative dividends
+      code.emit({0xC1, 0xF8, 0x1F});                               // sar eax, 31
+      code.emit({0xC1, 0xE8, static_cast<uint8_t>(32 - plan.shift)}); // shr eax, 32 - shift
+      code.emit({0x01, 0xF8});                                     // add eax, edi
+      code.emit({0xC1, 0xF8, plan.shift});                         // sar eax, shift
+    }
+    if (plan.negative) {
+      code.emit({0xF7, 0xD8}); // neg eax
+    }
+    return;
+  }
+  code.emit({0x48, 0x63, 0xC7}); // movsxd rax, edi
+  code.emit({0x48, 0x69, 0xC0}); // imul rax, rax, magic
+  code.emit32(static_cast<uint32_t>(plan.magic));
+  code.emit({0x48, 0xC1, 0xF8, 0x20}); // sar rax, 32
+  if (plan.add) {
+    code.emit({static_cast<uint8_t>(plan.negative ? 0x29 : 0x01), 0xF8}); // sub/add eax, edi
+  }
+  if (plan.shift != 0) {
+    code.emit({0xC1, 0xF8, plan.shift}); // sar eax, shift
+  }
+  code.emit({0x89, 0xC1});       // mov ecx, eax
+  code.emit({0xC1, 0xE9, 0x1F}); // shr ecx, 31
+  code.emit({0x01, 0xC8});       // add eax, ecx
+}
+
+inline void emit_divide(CodeBuffer &code, Divider<int64_t> const &divider) {
+  SignedPlan<int64_t> const plan = plan_signed(divider);
+  if (plan.pow2) {
+    code.emit({0x48, 0x89, 0xF8}); // mov rax, rdi
+    if (plan.shift != 0) {
+      code.emit({0x48, 0xC1, 0xF8, 0x3F});                               // sar rax, 63
+      code.emit({0x48, 0xC1, 0xE8, static_cast<uint8_t>(64 - plan.shift)}); // shr rax, 64 - shift
+      code.emit({0x48, 0x01, 0xF8});                                     // add rax, rdi
+      code.emit({0x48, 0xC1, 0xF8, plan.shift});                         // sar rax, shift
+    }
+    if (plan.negative) {
+      code.emit({0x48, 0xF7, 0xD8}); // neg rax
+    }
+    return;
+  }
+  code.emit({0x48, 0xB8}); // mov rax, magic
+  code.emit64(static_cast<uint64_t>(plan.magic));
+  code.emit({0x48, 0xF7, 0xEF}); // imul rdi
+  if (plan.add) {
+    code.emit({0x48, static_cast<uint8_t>(plan.negative ? 0x29 : 0x01), 0xFA}); // sub/add rdx, rdi
+  }
+  if (plan.shift != 0) {
+    code.emit({0x48, 0xC1, 0xFA, plan.shift}); // sar rdx, shift
+  }
+  code.emit({0x48, 0x89, 0xD0});       // mov rax, rdx
+  code.emit({0x48, 0xC1, 0xE8, 0x3F}); // shr rax, 63
+  code.emit({0x48, 0x01, 0xD0});       // add rax, rdx
+}
+
+// void f(const T *in, T *out, size_t n): the body above between a load from
+// [r8] and a store to [rsi]
+template <typename IntType> void emit_batch(CodeBuffer &code, Divider<IntType> const &divider) {
+  constexpr bool wide = sizeof(IntType) == 8;
+  constexpr uint8_t size = sizeof(IntType);
+  code.emit({0x49, 0x89, 0xF8}); // mov r8, rdi
+  code.emit({0x49, 0x89, 0xD1}); // mov r9, rdx
+  code.emit({0x4D, 0x85, 0xC9}); // test r9, r9
+  code.emit({0x0F, 0x84});       // jz done
+  size_t const skip = code.size();
+  code.emit32(0);
+  size_t const loop = code.size();
+  code.emit({static_cast<uint8_t>(wide ? 0x49 : 0x41), 0x8B, 0x38}); // mov edi/rdi, [r8]
+  emit_divide(code, divider);
+  if (wide) {
+    code.emit({0x48});
+  }
+  code.emit({0x89, 0x06});             // mov [rsi], eax/rax
+  code.emit({0x49, 0x83, 0xC0, size}); // add r8, size
+  code.emit({0x48, 0x83, 0xC6, size}); // add rsi, size
+  code.emit({0x49, 0xFF, 0xC9});       // dec r9
+  code.emit({0x0F, 0x85});             // jnz loop
+  code.emit32(0);
+  code.patch_rel32(code.size() - 4, loop);
+  code.patch_rel32(skip, code.size());
+  code.emit({0xC3}); // ret
+}
+
+} // namespace jit
+
+template <typename IntType> class JitDivider {
+  static_assert(std::is_integral<IntType>::value && (sizeof(IntType) == 4 || sizeof(IntType) == 8), "JitDivider supports 32- and 64-bit integers");
+
+public:
+  using Function = IntType (*)(IntType);
+  using BatchFunction = void (*)(const IntType *, IntType *, size_t);
+
+  // allow_jit = false skips code generation, e.g. to compare against the fallback
+  explicit JitDivider(IntType divisor, bool allow_jit = true) : divider_(divisor) {
+    if (allow_jit) {
+      compile();
+    }
+  }
+
+  ~JitDivider() {
+    release();
+  }
+
+  JitDivider(JitDivider const &) = delete;
+  JitDivider &operator=(JitDivider const &) = delete;
+
+  JitDivider(JitDivider &&other) noexcept
+      : divider_(other.divider_), page_(other.page_), page_size_(other.page_size_), function_(other.function_), batch_(other.batch_) {
+    other.page_ = nullptr;
+    other.function_ = nullptr;
+    other.batch_ = nullptr;
+  }
+
+  IntType divide(IntType dividend) const {
+    return function_ != nullptr ? function_(dividend) : divider_.divide(dividend);
+  }
+
+  void divide(const IntType *in, IntType *out, size_t n) const {
+    if (batch_ != nullptr) {
+      batch_(in, out, n);
+    } else {
+      dispatch_kernels<IntType>().divide_batch(in, out, n, divider_);
+    }
+  }
+
+  bool compiled() const {
+    return function_ != nullptr;
+  }
+  // nullptr when not compiled
+  Function function() const {
+    return function_;
+  }
+  BatchFunction batch_function() const {
+    return batch_;
+  }
+  Divider<IntType> const &divider() const {
+    return divider_;
+  }
+
+private:
+  void compile() {
+#ifdef DIVTOMULTI_JIT_X64
+    jit::CodeBuffer code;
+    jit::emit_divide(code, divider_);
+    code.emit({0xC3}); // ret
+    code.align(64);
+    size_t const batch_offset = code.size();
+    jit::emit_batch(code, divider_);
+
+    long const page = sysconf(_SC_PAGESIZE);
+    page_size_ = page > 0 ? static_cast<size_t>(page) : 4096;
+    page_size_ = (code.size() + page_size_ - 1) / page_size_ * page_size_;
+    void *const mapping = mmap(nullptr, page_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+      return;
+    }
+    std::memcpy(mapping, code.data(), code.size());
+    if (mprotect(mapping, page_size_, PROT_READ | PROT_EXEC) != 0) {
+      munmap(mapping, page_size_);
+      return;
+    }
+    page_ = mapping;
+    // Object to function pointer: conditionally supported, and what every JIT does
+    function_ = reinterpret_cast<Function>(page_);
+    batch_ = reinterpret_cast<BatchFunction>(static_cast<uint8_t *>(page_) + batch_offset);
+#endif
+  }
+
+  void release() {
+#ifdef DIVTOMULTI_JIT_X64
+    if (page_ != nullptr) {
+      munmap(page_, page_size_);
+    }
+#endif
+    page_ = nullptr;
+  }
+
+  Divider<IntType> divider_;
+  void *page_ = nullptr;
+  size_t page_size_ = 0;
+  Function function_ = nullptr;
+  BatchFunction batch_ = nullptr;
+};
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+#include "intrinsics.h"
+
+// =============================================================================
+// Common magic number calculation templates (similar to LLVM's approach)
+// =============================================================================
+
+// Type traits for selecting wider type for intermediate calculations
+template <typename T> struct WiderType;
+template <> struct WiderType<uint32_t> {
+  using type = uint64_t;
+};
+template <> struct WiderType<uint64_t> {
+  using type = uint128;
+};
+template <> struct WiderType<int32_t> {
+  using type = int64_t;
+};
+template <> struct WiderType<int64_t> {
+  using type = uint128;
+}; // Use uint128 for intermediate
+
+// Unsigned division magic number result
+template <typename UIntType> struct UnsignedDivMagic {
+  UIntType magic;
+  unsigned shift;
+  bool is_add;
+};
+
+// LLVM-style magic number calculation for unsigned division
+// Based on "Hacker's Delight" chapter 10 and LLVM's UnsignedDivisionByConstantInfo
+template <typename UIntType> constexpr UnsignedDivMagic<UIntType> get_unsigned_magic(UIntType d) {
+  static_assert(std::is_unsigned<UIntType>::value, "UIntType must be unsigned");
+  assert(d > 1 && "Divisor must be > 1");
+
+  using WideType = typename WiderType<UIntType>::type;
+  constexpr unsigned B = sizeof(UIntType) * 8;
+
+  WideType const all_ones = static_cast<WideType>(static_cast<UIntType>(-1)); // 2^B - 1
+  WideType const signed_min = static_cast<WideType>(1) << (B - 1);            // 2^(B-1)
+  WideType const signed_max = signed_min - 1;                                 // 2^(B-1) - 1
+
+  // NC = largest dividend such that NC % d == d - 1
+  WideType const nc = all_ones - (all_ones + 1 - d) % d;
+
+  unsigned p = B - 1;
+
+  // Initialize Q1 = 2^p / NC, R1 = 2^p % NC
+  WideType q1 = signed_min / nc;
+  WideType r1 = signed_min % nc;
+
+  // Initialize Q2 = (2^p - 1) / D, R2 = (2^p - 1) % D
+  WideType q2 = signed_max / d;
+  WideType r2 = signed_max % d;
+
+  bool is_add = false;
+
+  WideType delta = 0;
+  do {
+    p = p + 1;
+
+    if (r1 >= nc - r1) {
+      q1 = (q1 << 1) + 1;
+      r1 = (r1 << 1) - nc;
+    } else {
+      q1 = q1 << 1;
+      r1 = r1 << 1;
+    }
+
+    if (r2 + 1 >= d - r2) {
+      if (q2 >= signed_max) {
+        is_add = true;
+      }
+      q2 = (q2 << 1) + 1;
+      r2 = (r2 << 1) + 1 - d;
+    } else {
+      if (q2 >= signed_min) {
+        is_add = true;
+      }
+      q2 = q2 << 1;
+      r2 = (r2 << 1) + 1;
+    }
+
+    delta = d - 1 - r2;
+  } while (p < B * 2 && (q1 < delta || (q1 == delta && r1 == 0)));
+
+  UIntType magic = static_cast<UIntType>(q2 + 1);
+  unsigned shift = p - B;
+
+  // When is_add is true, reduce shift by 1 (correction is done in computation)
+  if (is_add) {
+    assert(shift > 0 && "Unexpected shift");
+    shift -= 1;
+  }
+
+  return {magic, shift, is_add};
+}
+
+// Same (magic, shift, is_add) as get_unsigned_magic, for runtime divisors.
+// The loop above climbs from p = B one bit at a time, after three double-width
+// divisions. Here one double-width division gives 2^p / d at
+// p = B + ceil(log2 d), where the magic always fits, and the quotient and
+// remainder are halved down to the smallest p that still works. That is
+// usually one or two steps.
+template <typename UIntType> UnsignedDivMagic<UIntType> get_unsigned_magic_fast(UIntType d) {
+  static_assert(std::is_unsigned<UIntType>::value, "UIntType must be unsigned");
+  assert(d > 1 && "Divisor must be > 1");
+
+  using WideType = typename WiderType<UIntType>::type;
+  constexpr unsigned B = sizeof(UIntType) * 8;
+
+  // NC = largest dividend such that NC % d == d - 1
+  WideType const nc = static_cast<WideType>(static_cast<UIntType>(-1) - static_cast<UIntType>(0U - d) % d);
+
+  // 2^(B + l) = (2^B + q) * d + r, with 2^l - d computed modulo 2^B so l == B works too
+  unsigned const l = 64U - static_cast<unsigned>(clzll(static_cast<uint64_t>(d - 1)));
+  UIntType const high = static_cast<UIntType>((l == B ? UIntType(0) : static_cast<UIntType>(UIntType(1) << l)) - d);
+  WideType const wide = (static_cast<WideType>(high) << B) / d;
+  WideType q = (static_cast<WideType>(1) << B) + wide;
+  WideType r = (static_cast<WideType>(high) << B) - wide * d;
+  unsigned p = B + l;
+
+  // 2^p / d rounded up is exact for every B-bit dividend iff 2^p > NC * (d - 2^p % d) % d.
+  // The condition only gets easier as p grows, so stop at the first p that fails it.
+  while (p > B) {
+    WideType const half_q = q >> 1;
+    WideType const half_r = (q & 1) ? (r + d) >> 1 : r >> 1;
+    WideType const error = half_r == 0 ? WideType(0) : d - half_r;
+    if (nc * error >= (static_cast<WideType>(1) << (p - 1))) {
+      break;
+    }
+    q = half_q;
+    r = half_r;
+    --p;
+  }
+
+  WideType const magic = q + (r != 0 ? 1U : 0U);
+  bool const is_add = magic > static_cast<UIntType>(-1);
+  return {static_cast<UIntType>(magic), p - B - (is_add ? 1U : 0U), is_add};
+}
+
+// Signed division magic number result
+template <typename SIntType> struct SignedDivMagic {
+  SIntType magic;
+  unsigned shift;
+};
+
+// LLVM-style magic number calculation for signed division
+// Based on "Hacker's Delight" chapter 10 and LLVM's SignedDivisionByConstantInfo
+template <typename SIntType> constexpr SignedDivMagic<SIntType> get_signed_magic(SIntType d) {
+  static_assert(std::is_signed<SIntType>::value, "SIntType must be signed");
+  assert(d != 0 && d != 1 && d != -1 && "Divisor must not be 0, 1, or -1");
+
+  using UIntType = typename std::make_unsigned<SIntType>::type;
+  using WideType = typename WiderType<UIntType>::type;
+  constexpr unsigned B = sizeof(SIntType) * 8;
+
+  WideType const signed_min = static_cast<WideType>(1) << (B - 1); // 2^(B-1)
+
+  UIntType const ad = d < 0 ? static_cast<UIntType>(-d) : static_cast<UIntType>(d);
+
+  // T = 2^(B-1) + sign_bit
+  WideType const t = signed_min + (static_cast<UIntType>(d) >> (B - 1));
+  // ANC = T - 1 - T % |D|
+  WideType const anc = t - 1 - t % ad;
+
+  unsigned p = B - 1;
+  WideType q1 = signed_min / anc;
+  WideType r1 = signed_min % anc;
+  WideType q2 = signed_min / ad;
+  WideType r2 = signed_min % ad;
+
+  WideType delta = 0;
+  do {
+    p = p + 1;
+    q1 = q1 << 1;
+    r1 = r1 << 1;
+    if (r1 >= anc) {
+      ++q1;
+      r1 -= anc;
+    }
+    q2 = q2 << 1;
+    r2 = r2 << 1;
+    if (r2 >= ad) {
+      ++q2;
+      r2 -= ad;
+    }
+    delta = ad - r2;
+  } while (q1 < delta || (q1 == delta && r1 == 0));
+
+  SIntType magic = static_cast<SIntType>(q2 + 1);
+  if (d < 0) {
+    magic = -magic;
+  }
+
+  return {magic, p - B};
+}
+
+// Divisibility test magic result: dividend % d == 0 iff
+// rotate_right(dividend * inverse + bias, shift) <= limit
+template <typename UIntType> struct DivisibilityMagic {
+  UIntType inverse; // inverse of the odd part of |d| modulo 2^B
+  UIntType bias;    // 0 for unsigned; moves signed multiples of d into [0, 2 * bias]
+  UIntType limit;
+  unsigned shift; // trailing zeros of |d|
+};
+
+template <typename UIntType> constexpr unsigned trailing_zeros(UIntType x) {
+  unsigned n = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    ++n;
+  }
+  return n;
+}
+
+template <typename UIntType> constexpr UIntType rotate_right(UIntType x, unsigned k) {
+  constexpr unsigned B = sizeof(UIntType) * 8;
+  return static_cast<UIntType>((x >> k) | (x << ((0U - k) & (B - 1))));
+}
+
+// Newton iteration for the inverse of an odd number modulo 2^B;
+// x = d is already correct to 3 bits and every step doubles that
+template <typename UIntType> constexpr UIntType odd_inverse(UIntType d) {
+  constexpr unsigned B = sizeof(UIntType) * 8;
+  UIntType x = d;
+  for (unsigned bits = 3; bits < B; bits *= 2) {
+    x = static_cast<UIntType>(x * static_cast<UIntType>(2 - d * x));
+  }
+  return x;
+}
+
+// Granlund-Montgomery divisibility test, see "Hacker's Delight" section 10-17
+// and LLVM's prepareUREMEqFold. Multiplying by the inverse of the odd part
+// maps the multiples of d onto [0, MAX / d] after the rotation strips the
+// power-of-two factor, and everything else lands above that.
+template <typename UIntType> constexpr DivisibilityMagic<UIntType> get_unsigned_divisibility_magic(UIntType d) {
+  static_assert(std::is_unsigned<UIntType>::value, "UIntType must be unsigned");
+  assert(d != 0 && "Divisor must not be 0");
+
+  unsigned const shift = trailing_zeros(d);
+  return {odd_inverse(static_cast<UIntType>(d >> shift)), 0, static_cast<UIntType>(static_cast<UIntType>(-1) / d), shift};
+}
+
+// Signed variant after LLVM's prepareSREMEqFold: the bias centres the signed
+// multiples of |d| around zero before the same rotate-and-compare
+template <typename SIntType> constexpr DivisibilityMagic<typename std::make_unsigned<SIntType>::type> get_signed_divisibility_magic(SIntType d) {
+  static_assert(std::is_signed<SIntType>::value, "SIntType must be signed");
+  assert(d != 0 && "Divisor must not be 0");
+
+  using UIntType = typename std::make_unsigned<SIntType>::type;
+  UIntType const ad = d < 0 ? 0U - static_cast<UIntType>(d) : static_cast<UIntType>(d);
+  unsigned const shift = trailing_zeros(ad);
+  UIntType const odd = ad >> shift;
+
+  // Powers of two only test the low bits, which the unsigned form already does for INT_MIN too
+  if (odd == 1) {
+    return {1, 0, static_cast<UIntType>(static_cast<UIntType>(-1) >> shift), shift};
+  }
+
+  UIntType const q = (static_cast<UIntType>(-1) >> 1) / odd;
+  UIntType const bias = q & (0U - (static_cast<UIntType>(1) << shift));
+  return {odd_inverse(odd), bias, static_cast<UIntType>(static_cast<UIntType>(bias << 1) >> shift), shift};
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "intrinsics.h"
+#include "magic.h"
+#include "wide.h"
+
+// =============================================================================
+// Modular arithmetic
+// =============================================================================
+
+// (a * b) % m for a runtime modulus without a double-width division per
+// product. Like Divider<T>, both contexts do their divisions once in the
+// constructor. Operands must already be reduced: a, b < m.
+
+// Barrett reduction: the product is divided by m through a precomputed
+// reciprocal, then corrected once.
+template <typename UIntType> class Barrett;
+
+template <> class Barrett<uint32_t> {
+public:
+  // reciprocal = floor((2^64 - 1) / m): for products below m^2 the
+  // estimated quotient umulh(p, reciprocal) is at most one too small
+  explicit Barrett(uint32_t modulus) : modulus_(modulus), reciprocal_(static_cast<uint64_t>(-1) / modulus) {
+    assert(modulus != 0 && "Modulus must not be 0");
+  }
+
+  uint32_t reduce(uint64_t product) const {
+    uint64_t const quotient = umulh(product, reciprocal_);
+    // Kept in 64 bits: for moduli above 2^31 the uncorrected r reaches 2m - 1
+    uint64_t const r = product - quotient * modulus_;
+    return static_cast<uint32_t>(r >= modulus_ ? r - modulus_ : r);
+  }
+
+  uint32_t mulmod(uint32_t a, uint32_t b) const {
+    return reduce(static_cast<uint64_t>(a) * b);
+  }
+
+  uint32_t powmod(uint32_t base, uint64_t exponent) const {
+    uint32_t result = modulus_ == 1 ? 0 : 1;
+    for (; exponent != 0; exponent >>= 1) {
+      if ((exponent & 1) != 0) {
+        result = mulmod(result, base);
+      }
+      base = mulmod(base, base);
+    }
+    return result;
+  }
+
+  void mulmod(const uint32_t *a, const uint32_t *b, uint32_t *out, size_t n) const {
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = mulmod(a[i], b[i]);
+    }
+  }
+
+  uint32_t modulus() const {
+    return modulus_;
+  }
+
+private:
+  uint32_t modulus_;
+  uint64_t reciprocal_;
+};
+
+// The 128-bit product is reduced with WideDivider's normalized reciprocal
+// (Moller-Granlund), a Barrett step with the correction built in. The high
+// word of a product of residues is below m, so one 2-by-1 step is enough.
+template <> class Barrett<uint64_t> {
+public:
+  explicit Barrett(uint64_t modulus) : divider_(modulus) {
+  }
+
+  uint64_t reduce(uint128 product) const {
+    return divider_.remainder(static_cast<uint64_t>(product >> 64), static_cast<uint64_t>(product));
+  }
+
+  uint64_t mulmod(uint64_t a, uint64_t b) const {
+    return reduce(static_cast<uint128>(a) * b);
+  }
+
+  uint64_t powmod(uint64_t base, uint64_t exponent) const {
+    uint64_t result = modulus() == 1 ? 0 : 1;
+    for (; exponent != 0; exponent >>= 1) {
+      if ((exponent & 1) != 0) {
+        result = mulmod(result, base);
+      }
+      base = mulmod(base, base);
+    }
+    return result;
+  }
+
+  void mulmod(const uint64_t *a, const uint64_t *b, uint64_t *out, size_t n) const {
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = mulmod(a[i], b[i]);
+    }
+  }
+
+  uint64_t modulus() const {
+    return divider_.divisor();
+  }
+
+private:
+  WideDivider<uint64_t> divider_;
+};
+
+// Montgomery multiplication for odd moduli: values are kept as x * 2^B mod m,
+// where reducing a product only takes the low half times the inverse of m
+// (odd_inverse, as in the divisibility test) and a multiply-high.
+// mulmod() converts in and out for one-off products; powmod() and callers
+// chaining many products stay in Montgomery form in between.
+template <typename UIntType> class Montgomery {
+  static_assert(std::is_unsigned<UIntType>::value, "UIntType must be unsigned");
+
+  using WideType = typename WiderType<UIntType>::type;
+  static constexpr unsigned B = sizeof(UIntType) * 8;
+
+public:
+  explicit Montgomery(UIntType modulus) : modulus_(modulus), inverse_(odd_inverse(modulus)) {
+    assert((modulus & 1) != 0 && "Modulus must be odd");
+    one_ = static_cast<UIntType>(static_cast<UIntType>(0U - modulus) % modulus); // 2^B mod m
+    r2_ = static_cast<UIntType>(static_cast<WideType>(one_) * one_ % modulus);  // 2^2B mod m
+  }
+
+  // REDC: product * 2^-B mod m, for product < m * 2^B. product - q * m is a
+  // multiple of 2^B by the choice of q, so only the high halves are subtracted.
+  UIntType reduce(WideType product) const {
+    UIntType const q = static_cast<UIntType>(static_cast<UIntType>(product) * inverse_);
+    UIntType const high = static_cast<UIntType>(product >> B);
+    UIntType const qm_high = umulh(q, modulus_);
+    UIntType const r = static_cast<UIntType>(high - qm_high);
+    return high < qm_high ? static_cast<UIntType>(r + modulus_) : r;
+  }
+
+  UIntType to_montgomery(UIntType value) const {
+    return reduce(static_cast<WideType>(value) * r2_);
+  }
+
+  UIntType from_montgomery(UIntType value) const {
+    return reduce(static_cast<WideType>(value));
+  }
+
+  // Product of two values in Montgomery form, in Montgomery form
+  UIntType multiply(UIntType a, UIntType b) const {
+    return reduce(static_cast<WideType>(a) * b);
+  }
+
+  // a * b * 2^-B, then * 2^2B * 2^-B: two reductions and no conversion of b
+  UIntType mulmod(UIntType a, UIntType b) const {
+    return multiply(multiply(a, b), r2_);
+  }
+
+  UIntType powmod(UIntType base, uint64_t exponent) const {
+    UIntType result = one_;
+    UIntType power = to_montgomery(base);
+    for (; exponent != 0; exponent >>= 1) {
+      if ((exponent & 1) != 0) {
+        result = multiply(result, power);
+      }
+      power = multiply(power, power);
+    }
+    return from_montgomery(result);
+  }
+
+  void mulmod(const UIntType *a, const UIntType *b, UIntType *out, size_t n) const {
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = mulmod(a[i], b[i]);
+    }
+  }
+
+  UIntType modulus() const {
+    return modulus_;
+  }
+
+private:
+  UIntType modulus_;
+  UIntType inverse_; // m^-1 mod 2^B
+  UIntType one_;
+  UIntType r2_;
+};
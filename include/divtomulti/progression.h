@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "divider.h"
+#include "u32div.h"
+#include "u64div.h"
+
+// =============================================================================
+// Arithmetic progressions
+// =============================================================================
+
+// (base + i * step) / divisor and % divisor for i = 0, 1, 2, ...: offsets to
+// pages or tiles, strided indices to rows. Only the first term and step / d,
+// step % d are divided (with opt_cal); each later term is an add, a compare
+// and a conditional subtract, with no multiply at all.
+//
+// Terms are exact while base + i * step fits in UIntType. Past that the
+// quotient keeps counting the true value's, not the wrapped value's.
+template <typename UIntType> class DivisionProgression {
+  static_assert(std::is_unsigned<UIntType>::value && (sizeof(UIntType) == 4 || sizeof(UIntType) == 8), "32- or 64-bit unsigned only");
+
+public:
+  DivisionProgression(UIntType base, UIntType step, UIntType divisor) : divisor_(divisor) {
+    assert(divisor != 0 && "Divisor must not be 0");
+    quotient_ = opt_cal(base, divisor);
+    remainder_ = static_cast<UIntType>(base - quotient_ * divisor);
+    step_quotient_ = opt_cal(step, divisor);
+    step_remainder_ = static_cast<UIntType>(step - step_quotient_ * divisor);
+    // Compared against instead of d so that r + step % d never has to be formed
+    gap_ = static_cast<UIntType>(divisor - step_remainder_);
+  }
+
+  UIntType quotient() const {
+    return quotient_;
+  }
+  UIntType remainder() const {
+    return remainder_;
+  }
+  DivMod<UIntType> operator*() const {
+    return {quotient_, remainder_};
+  }
+
+  // r + step % d wraps past d exactly when r >= d - step % d
+  DivisionProgression &operator++() {
+    bool const wrap = remainder_ >= gap_;
+    remainder_ = wrap ? static_cast<UIntType>(remainder_ - gap_) : static_cast<UIntType>(remainder_ + step_remainder_);
+    quotient_ = static_cast<UIntType>(quotient_ + step_quotient_ + (wrap ? 1 : 0));
+    return *this;
+  }
+
+  // Batch forms: write the next n terms and move past them
+  void divide(UIntType *quotient, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      quotient[i] = quotient_;
+      ++*this;
+    }
+  }
+
+  void divmod(UIntType *quotient, UIntType *remainder, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      quotient[i] = quotient_;
+      remainder[i] = remainder_;
+      ++*this;
+    }
+  }
+
+  UIntType divisor() const {
+    return divisor_;
+  }
+  UIntType step_quotient() const {
+    return step_quotient_;
+  }
+  UIntType step_remainder() const {
+    return step_remainder_;
+  }
+
+private:
+  static UIntType opt_cal(UIntType dividend, UIntType divisor) {
+    if constexpr (sizeof(UIntType) == 4) {
+      return u32div::opt_cal(dividend, divisor);
+    } else {
+      return u64div::opt_cal(dividend, divisor);
+    }
+  }
+
+  UIntType divisor_;
+  UIntType quotient_;
+  UIntType remainder_;
+  UIntType step_quotient_;
+  UIntType step_remainder_;
+  UIntType gap_; // divisor - step % divisor, in [1, divisor]
+};
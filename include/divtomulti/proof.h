@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "intrinsics.h"
+#include "magic.h"
+
+// =============================================================================
+// Magic number proofs
+// =============================================================================
+
+// Little-endian 256-bit integer with just enough arithmetic for magic number proofs
+struct Uint256 {
+  uint64_t w[4];
+};
+
+inline Uint256 to_uint256(uint128 x) {
+  return {{static_cast<uint64_t>(x), static_cast<uint64_t>(x >> 64), 0, 0}};
+}
+
+inline Uint256 pow2_uint256(unsigned k) {
+  Uint256 r{{0, 0, 0, 0}};
+  r.w[k / 64] = 1ULL << (k % 64);
+  return r;
+}
+
+// Truncates to 256 bits; the proofs stay far below that
+inline Uint256 operator*(Uint256 const &a, uint64_t b) {
+  Uint256 r{{0, 0, 0, 0}};
+  uint64_t carry = 0;
+  for (int i = 0; i < 4; ++i) {
+    uint128 const t = static_cast<uint128>(a.w[i]) * b + carry;
+    r.w[i] = static_cast<uint64_t>(t);
+    carry = static_cast<uint64_t>(t >> 64);
+  }
+  return r;
+}
+
+// a - b for a >= b
+inline Uint256 operator-(Uint256 const &a, Uint256 const &b) {
+  Uint256 r{{0, 0, 0, 0}};
+  uint64_t borrow = 0;
+  for (int i = 0; i < 4; ++i) {
+    uint64_t const t = a.w[i] - b.w[i];
+    r.w[i] = t - borrow;
+    borrow = (a.w[i] < b.w[i] || t < borrow) ? 1 : 0;
+  }
+  return r;
+}
+
+inline int compare(Uint256 const &a, Uint256 const &b) {
+  for (int i = 3; i >= 0; --i) {
+    if (a.w[i] != b.w[i]) {
+      return a.w[i] < b.w[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+inline bool is_zero(Uint256 const &a) {
+  return (a.w[0] | a.w[1] | a.w[2] | a.w[3]) == 0;
+}
+
+// floor(n * magic / 2^k) == floor(n / d) for every 0 <= n <= n_max.
+// With e = magic * d - 2^k and n = q * d + r this needs 0 <= r + n * e / 2^k < d.
+// The excess n * e - 2^k * (d - r) grows within each quotient block and from
+// block to block, so only the last full block end (r = d - 1) and n_max can fail.
+inline bool proves_floor(Uint256 const &magic, uint64_t d, unsigned k, uint64_t n_max) {
+  Uint256 const scale = pow2_uint256(k);
+  Uint256 const md = magic * d;
+  if (d > n_max) {
+    // Every quotient is 0
+    return compare(magic * n_max, scale) < 0;
+  }
+  if (compare(md, scale) < 0) {
+    return false; // n = d would round down to 0
+  }
+  Uint256 const e = md - scale;
+  uint64_t const n_c = n_max - (n_max - (d - 1)) % d;
+  uint64_t const r_top = n_max % d;
+  return compare(e * n_c, scale) < 0 && compare(e * n_max, scale * (d - r_top)) < 0;
+}
+
+// floor(-m * magic / 2^k) == -floor(m / d) - 1 for every 1 <= m <= m_max: the
+// signed quotient of a negative dividend before the round-toward-zero +1.
+// Here exact multiples need e > 0 and the rest r + m * e / 2^k <= d.
+inline bool proves_ceil(Uint256 const &magic, uint64_t d, unsigned k, uint64_t m_max) {
+  Uint256 const scale = pow2_uint256(k);
+  Uint256 const md = magic * d;
+  if (d > m_max) {
+    return compare(magic * m_max, scale) <= 0 && !is_zero(magic);
+  }
+  if (compare(md, scale) <= 0) {
+    return false;
+  }
+  Uint256 const e = md - scale;
+  uint64_t const m_c = m_max - (m_max - (d - 1)) % d;
+  uint64_t const r_top = m_max % d;
+  return compare(e * m_c, scale) <= 0 && compare(e * m_max, scale * (d - r_top)) <= 0;
+}
+
+// Proves umulh-based division with dm correct for every dividend in [0, MAX].
+// Both strategies compute floor(n * magic' / 2^k): the add form uses
+// magic' = 2^B + magic and one extra bit of shift.
+template <typename UIntType> bool prove_unsigned_magic(UIntType d, UnsignedDivMagic<UIntType> dm) {
+  static_assert(std::is_unsigned<UIntType>::value, "UIntType must be unsigned");
+  constexpr unsigned B = sizeof(UIntType) * 8;
+
+  uint128 const magic = static_cast<uint128>(dm.magic) + (dm.is_add ? static_cast<uint128>(1) << B : 0);
+  unsigned const k = B + dm.shift + (dm.is_add ? 1 : 0);
+  return proves_floor(to_uint256(magic), d, k, static_cast<UIntType>(-1));
+}
+
+// Proves smulh-based division with dm correct for every dividend in [MIN, MAX].
+// After the add/subtract correction the quotient is floor(n' * P / 2^k) for
+// n' = n * sign(d) and P = |magic'|, rounded toward zero when negative, so the
+// non-negative and negative dividends are two floor/ceil proofs on |d|.
+template <typename SIntType> bool prove_signed_magic(SIntType d, SignedDivMagic<SIntType> dm) {
+  static_assert(std::is_signed<SIntType>::value, "SIntType must be signed");
+  using UIntType = typename std::make_unsigned<SIntType>::type;
+  constexpr unsigned B = sizeof(SIntType) * 8;
+
+  UIntType const ad = d < 0 ? 0U - static_cast<UIntType>(d) : static_cast<UIntType>(d);
+  // d > 0: magic, or 2^B + magic when it overflowed into the sign bit; d < 0 mirrors that
+  UIntType const p = d > 0 ? static_cast<UIntType>(dm.magic) : 0U - static_cast<UIntType>(dm.magic);
+  unsigned const k = B + dm.shift;
+
+  // For d < 0, n' = -n runs up to 2^(B-1) (from MIN) and down to -(2^(B-1) - 1)
+  uint64_t const half = static_cast<uint64_t>(1) << (B - 1);
+  uint64_t const n_max = d > 0 ? half - 1 : half;
+  uint64_t const m_max = d > 0 ? half : half - 1;
+  return proves_floor(to_uint256(p), ad, k, n_max) && proves_ceil(to_uint256(p), ad, k, m_max);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+#include "batch.h"
+#include "dispatch.h"
+#include "divider.h"
+
+// =============================================================================
+// Mixed-radix decomposition
+// =============================================================================
+
+// Splits a value into digits of a mixed radix, least significant first:
+// linear index -> tensor coordinates, or seconds -> {60, 60, 24} -> seconds,
+// minutes, hours, with the days left over as the final quotient. Each stage
+// is a Divider<T> built once, so the chain of divides becomes a chain of
+// multiply-highs.
+template <typename UIntType> class MixedRadix {
+  static_assert(std::is_unsigned<UIntType>::value, "UIntType must be unsigned");
+
+public:
+  explicit MixedRadix(std::initializer_list<UIntType> radices) : MixedRadix(radices.begin(), radices.size()) {
+  }
+
+  MixedRadix(const UIntType *radices, size_t count) {
+    stages_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      assert(radices[i] != 0 && "Radix must not be 0");
+      stages_.emplace_back(radices[i]);
+    }
+  }
+
+  // Writes size() digits and returns what is left above the last radix
+  UIntType decompose(UIntType value, UIntType *digits) const {
+    for (size_t s = 0; s < stages_.size(); ++s) {
+      DivMod<UIntType> const qr = stages_[s].divmod(value);
+      digits[s] = qr.remainder;
+      value = qr.quotient;
+    }
+    return value;
+  }
+
+  // Batch form: digits[s] receives stage s of every value and high the
+  // leftover quotients. Values go through the dispatched divmod kernel one
+  // block at a time, so each stage's quotients feed the next while in L1.
+  void decompose(const UIntType *in, size_t n, UIntType *const *digits, UIntType *high) const {
+    if (stages_.empty()) {
+      std::copy(in, in + n, high);
+      return;
+    }
+    DivisionKernels<UIntType> const &kernels = dispatch_kernels<UIntType>();
+    UIntType quotients[2][kRemainderBlock];
+    for (size_t i = 0; i < n; i += kRemainderBlock) {
+      size_t const block = std::min(kRemainderBlock, n - i);
+      const UIntType *src = in + i;
+      for (size_t s = 0; s < stages_.size(); ++s) {
+        UIntType *const dst = s + 1 == stages_.size() ? high + i : quotients[s & 1];
+        kernels.divmod_batch(src, dst, digits[s] + i, block, stages_[s]);
+        src = dst;
+      }
+    }
+  }
+
+  size_t size() const {
+    return stages_.size();
+  }
+  UIntType radix(size_t stage) const {
+    return stages_[stage].divisor();
+  }
+
+private:
+  std::vector<Divider<UIntType>> stages_;
+};
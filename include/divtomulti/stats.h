@@ -0,0 +1,277 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+// =============================================================================
+// Hot-path instrumentation
+// =============================================================================
+
+// Which branches of opt_cal / opt_cal_signed a program actually takes, and
+// which divisors it passes, to decide what to specialize (ConstDivider),
+// cache (DividerCache) or batch. Off unless DIVTOMULTI_STATS is defined (the
+// DIVTOMULTI_STATS CMake option): DIVTOMULTI_STATS_COUNT then expands to
+// nothing and does not evaluate its arguments. The snapshot API below is
+// always there and reads zeros when nothing was counted.
+//
+// Every thread counts into its own cache-line aligned block, so counting is
+// a relaxed load and store with no shared line. snapshot() sums the live
+// blocks and those of threads that have exited.
+#ifdef DIVTOMULTI_STATS
+#define DIVTOMULTI_STATS_COUNT(path, divisor) ::stats::record(::stats::DivPath::path, divisor)
+#else
+#define DIVTOMULTI_STATS_COUNT(path, divisor) ((void)0)
+#endif
+
+namespace stats {
+
+constexpr bool enabled() {
+#ifdef DIVTOMULTI_STATS
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Branches of the scalar paths. Each call counts exactly one of Overflow
+// through MulAddShift; NegativeMagic is counted on top of MulShift or
+// MulAddShift when the signed magic number is negative. MulAddShift is the
+// is_add fixup for unsigned widths and the +-dividend fixup for signed ones.
+enum class DivPath : unsigned { Overflow, One, MinusOne, Pow2, Large, MulShift, MulAddShift, NegativeMagic, Count };
+constexpr size_t kPaths = static_cast<size_t>(DivPath::Count);
+
+enum class Width : unsigned { U32, I32, U64, I64, Count };
+constexpr size_t kWidths = static_cast<size_t>(Width::Count);
+
+// One divisor in every kSampleEvery calls per thread goes to the histogram,
+// a table of up to kSlots distinct values per thread. Samples of a new value
+// that find the table full are only counted as dropped.
+#ifndef DIVTOMULTI_STATS_SAMPLE_EVERY
+#define DIVTOMULTI_STATS_SAMPLE_EVERY 64
+#endif
+constexpr uint64_t kSampleEvery = DIVTOMULTI_STATS_SAMPLE_EVERY;
+constexpr size_t kSlots = 256;
+
+inline char const *path_name(DivPath path) {
+  static char const *const names[] = {"overflow", "one", "minus_one", "pow2", "large", "mul_shift", "mul_add_shift", "negative_magic"};
+  return names[static_cast<size_t>(path)];
+}
+
+inline char const *width_name(Width width) {
+  static char const *const names[] = {"u32", "i32", "u64", "i64"};
+  return names[static_cast<size_t>(width)];
+}
+
+template <typename IntType> constexpr Width width_of() {
+  static_assert(std::is_integral<IntType>::value && (sizeof(IntType) == 4 || sizeof(IntType) == 8), "32- and 64-bit divisors only");
+  return sizeof(IntType) == 4 ? (std::is_signed<IntType>::value ? Width::I32 : Width::U32) : (std::is_signed<IntType>::value ? Width::I64 : Width::U64);
+}
+
+struct Snapshot {
+  uint64_t paths[kWidths][kPaths] = {};
+  // Sampled divisors per width: signed ones sign-extended, unsigned ones by bit pattern
+  std::map<int64_t, uint64_t> divisors[kWidths];
+  uint64_t samples = 0; // sampled calls, including dropped ones
+  uint64_t dropped = 0; // samples whose thread table was full
+
+  uint64_t calls(Width width) const {
+    uint64_t sum = 0;
+    for (size_t p = 0; p < kPaths; ++p) {
+      sum += p == static_cast<size_t>(DivPath::NegativeMagic) ? 0 : paths[static_cast<size_t>(width)][p];
+    }
+    return sum;
+  }
+  uint64_t count(Width width, DivPath path) const {
+    return paths[static_cast<size_t>(width)][static_cast<size_t>(path)];
+  }
+};
+
+namespace detail {
+
+// Only the owning thread writes; snapshot() and reset() load and store
+// without it, so a count that races a reset() may survive it
+inline void bump(std::atomic<uint64_t> &counter, uint64_t n = 1) {
+  counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+struct alignas(64) ThreadStats {
+  std::atomic<uint64_t> paths[kWidths][kPaths] = {};
+  std::atomic<uint64_t> tick{0};
+  std::atomic<uint64_t> dropped{0};
+  // Open addressing on the divisor; a slot with count 0 is free
+  struct Slot {
+    std::atomic<uint64_t> key{0};
+    std::atomic<uint32_t> width{0};
+    std::atomic<uint64_t> count{0};
+  } slots[kSlots];
+
+  void add_to(Snapshot &out) const {
+    for (size_t w = 0; w < kWidths; ++w) {
+      for (size_t p = 0; p < kPaths; ++p) {
+        out.paths[w][p] += paths[w][p].load(std::memory_order_relaxed);
+      }
+    }
+    for (Slot const &slot : slots) {
+      uint64_t const count = slot.count.load(std::memory_order_relaxed);
+      if (count != 0) {
+        out.divisors[slot.width.load(std::memory_order_relaxed)][static_cast<int64_t>(slot.key.load(std::memory_order_relaxed))] += count;
+        out.samples += count;
+      }
+    }
+    uint64_t const lost = dropped.load(std::memory_order_relaxed);
+    out.dropped += lost;
+    out.samples += lost;
+  }
+
+  void clear() {
+    for (auto &row : paths) {
+      for (auto &counter : row) {
+        counter.store(0, std::memory_order_relaxed);
+      }
+    }
+    for (Slot &slot : slots) {
+      slot.count.store(0, std::memory_order_relaxed);
+    }
+    dropped.store(0, std::memory_order_relaxed);
+  }
+
+  void sample(Width width, uint64_t key) {
+    size_t const start = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 56) % kSlots;
+    for (size_t probe = 0; probe < kSlots; ++probe) {
+      Slot &slot = slots[(start + probe) % kSlots];
+      uint64_t const count = slot.count.load(std::memory_order_relaxed);
+      if (count == 0) {
+        slot.key.store(key, std::memory_order_relaxed);
+        slot.width.store(static_cast<uint32_t>(width), std::memory_order_relaxed);
+        slot.count.store(1, std::memory_order_relaxed);
+        return;
+      }
+      if (slot.key.load(std::memory_order_relaxed) == key && slot.width.load(std::memory_order_relaxed) == static_cast<uint32_t>(width)) {
+        slot.count.store(count + 1, std::memory_order_relaxed);
+        return;
+      }
+    }
+    bump(dropped);
+  }
+};
+
+class Registry {
+public:
+  void attach(ThreadStats *stats) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    live_.push_back(stats);
+  }
+
+  // An exiting thread's counts move to the retired totals
+  void detach(ThreadStats *stats) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats->add_to(retired_);
+    for (size_t i = 0; i < live_.size(); ++i) {
+      if (live_[i] == stats) {
+        live_[i] = live_.back();
+        live_.pop_back();
+        break;
+      }
+    }
+  }
+
+  Snapshot snapshot() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Snapshot out = retired_;
+    for (ThreadStats const *stats : live_) {
+      stats->add_to(out);
+    }
+    return out;
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired_ = Snapshot();
+    for (ThreadStats *stats : live_) {
+      stats->clear();
+    }
+  }
+
+private:
+  std::mutex mutex_;
+  std::vector<ThreadStats *> live_;
+  Snapshot retired_;
+};
+
+inline Registry &registry() {
+  static Registry instance;
+  return instance;
+}
+
+struct ThreadHandle {
+  ThreadStats stats;
+  ThreadHandle() {
+    registry().attach(&stats);
+  }
+  ~ThreadHandle() {
+    registry().detach(&stats);
+  }
+};
+
+inline ThreadStats &local() {
+  thread_local ThreadHandle handle;
+  return handle.stats;
+}
+
+} // namespace detail
+
+template <typename IntType> void record(DivPath path, IntType divisor) {
+  constexpr Width width = width_of<IntType>();
+  detail::ThreadStats &stats = detail::local();
+  detail::bump(stats.paths[static_cast<size_t>(width)][static_cast<size_t>(path)]);
+  if (path == DivPath::NegativeMagic) {
+    return; // the same call is sampled under its main path
+  }
+  uint64_t const tick = stats.tick.load(std::memory_order_relaxed);
+  stats.tick.store(tick + 1, std::memory_order_relaxed);
+  if (tick % kSampleEvery == 0) {
+    stats.sample(width, static_cast<uint64_t>(static_cast<int64_t>(divisor)));
+  }
+}
+
+inline Snapshot snapshot() {
+  return detail::registry().snapshot();
+}
+
+inline void reset() {
+  detail::registry().reset();
+}
+
+// width,kind,key,count lines: kind "path" with the branch name as key, or
+// "divisor" with a sampled divisor value
+inline void write_csv(std::ostream &out, Snapshot const &snap) {
+  out << "width,kind,key,count\n";
+  for (size_t w = 0; w < kWidths; ++w) {
+    char const *const width = width_name(static_cast<Width>(w));
+    for (size_t p = 0; p < kPaths; ++p) {
+      if (snap.paths[w][p] != 0) {
+        out << width << ",path," << path_name(static_cast<DivPath>(p)) << ',' << snap.paths[w][p] << '\n';
+      }
+    }
+    for (auto const &entry : snap.divisors[w]) {
+      out << width << ",divisor,";
+      if (w == static_cast<size_t>(Width::U32) || w == static_cast<size_t>(Width::U64)) {
+        out << static_cast<uint64_t>(entry.first);
+      } else {
+        out << entry.first;
+      }
+      out << ',' << entry.second << '\n';
+    }
+  }
+  if (snap.dropped != 0) {
+    out << "all,dropped,," << snap.dropped << '\n';
+  }
+}
+
+} // namespace stats
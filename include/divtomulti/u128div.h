@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+#include "intrinsics.h"
+#include "wide.h"
+
+// =============================================================================
+// u128div namespace
+// =============================================================================
+
+namespace u128div {
+
+// 128-bit dividend, 64-bit divisor; the quotient needs all 128 bits.
+// opt_cal and opt_rem build a WideDivider per call, whose reciprocal is itself
+// a 128-by-64 division, so one call costs more than normal_cal. They only pay
+// off through a WideDivider<uint64_t> kept for many dividends.
+inline uint128 opt_cal(uint128 dividend, uint64_t divisor) {
+  return WideDivider<uint64_t>(divisor).divide(dividend);
+}
+
+inline uint128 normal_cal(uint128 dividend, uint64_t divisor) {
+  return dividend / divisor;
+}
+
+inline uint64_t opt_rem(uint128 dividend, uint64_t divisor) {
+  return WideDivider<uint64_t>(divisor).remainder(dividend);
+}
+
+inline uint64_t normal_rem(uint128 dividend, uint64_t divisor) {
+  return static_cast<uint64_t>(dividend % divisor);
+}
+
+} // namespace u128div
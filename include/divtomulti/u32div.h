@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cache.h"
+#include "dispatch.h"
+#include "divider.h"
+#include "fpdiv.h"
+#include "magic.h"
+#include "stats.h"
+
+// =============================================================================
+// u32div namespace
+// =============================================================================
+
+namespace u32div {
+
+// 32-bit division using umull-style: (dividend * magic) >> (32 + shift)
+inline uint32_t opt_cal(uint32_t dividend, uint32_t divisor) {
+  if (divisor == 1) {
+    DIVTOMULTI_STATS_COUNT(One, divisor);
+    return dividend;
+  }
+
+  // For large divisors (> UINT32_MAX/2), quotient can only be 0 or 1
+  if (divisor > (static_cast<uint32_t>(-1) >> 1)) {
+    DIVTOMULTI_STATS_COUNT(Large, divisor);
+    return dividend >= divisor ? 1 : 0;
+  }
+
+  auto const dm = get_unsigned_magic_fast(divisor);
+
+  // umull: 32x32 -> 64, then shift
+  uint64_t const product = static_cast<uint64_t>(dividend) * dm.magic;
+  uint32_t const high = static_cast<uint32_t>(product >> 32);
+
+  if (!dm.is_add) {
+    DIVTOMULTI_STATS_COUNT(MulShift, divisor);
+    // Simple case: just shift the high part
+    return high >> dm.shift;
+  } else {
+    // Correction case: (high + ((dividend - high) >> 1)) >> shift
+    DIVTOMULTI_STATS_COUNT(MulAddShift, divisor);
+    uint32_t const t = dividend - high;
+    return (high + (t >> 1)) >> dm.shift;
+  }
+}
+
+inline uint32_t normal_cal(uint32_t dividend, uint32_t divisor) {
+  return dividend / divisor;
+}
+
+inline uint32_t opt_rem(uint32_t dividend, uint32_t divisor) {
+  uint32_t quotient = opt_cal(dividend, divisor);
+  return dividend - divisor * quotient;
+}
+
+inline uint32_t normal_rem(uint32_t dividend, uint32_t divisor) {
+  return dividend % divisor;
+}
+
+// opt_cal with the magic number looked up in (or added to) a DividerCache,
+// for runtime divisors that repeat
+inline uint32_t opt_cal_cached(uint32_t dividend, uint32_t divisor, DividerCache<uint32_t> &cache = default_divider_cache<uint32_t>()) {
+  return cache.get(divisor).divide(dividend);
+}
+
+inline uint32_t opt_rem_cached(uint32_t dividend, uint32_t divisor, DividerCache<uint32_t> &cache = default_divider_cache<uint32_t>()) {
+  return cache.get(divisor).remainder(dividend);
+}
+
+inline void divide(const uint32_t *in, uint32_t *out, size_t n, Divider<uint32_t> const &divider) {
+  dispatch().u32.divide_batch(in, out, n, divider);
+}
+
+inline void divide(const uint32_t *in, uint32_t *out, size_t n, uint32_t divisor) {
+  divide(in, out, n, Divider<uint32_t>(divisor));
+}
+
+inline void remainder(const uint32_t *in, uint32_t *out, size_t n, Divider<uint32_t> const &divider) {
+  dispatch().u32.remainder_batch(in, out, n, divider);
+}
+
+inline void remainder(const uint32_t *in, uint32_t *out, size_t n, uint32_t divisor) {
+  remainder(in, out, n, Divider<uint32_t>(divisor));
+}
+
+// Batch forms on the floating-point units, to run beside the integer kernels
+inline void divide(const uint32_t *in, uint32_t *out, size_t n, FloatDivider<uint32_t> const &divider) {
+  dispatch().float_u32.divide_batch(in, out, n, divider);
+}
+
+inline void remainder(const uint32_t *in, uint32_t *out, size_t n, FloatDivider<uint32_t> const &divider) {
+  dispatch().float_u32.remainder_batch(in, out, n, divider);
+}
+
+// Quotient and remainder from one multiply-high; opt_rem would recompute the quotient
+inline DivMod<uint32_t> divmod(uint32_t dividend, uint32_t divisor) {
+  uint32_t const quotient = opt_cal(dividend, divisor);
+  return {quotient, dividend - divisor * quotient};
+}
+
+inline DivMod<uint32_t> divmod(uint32_t dividend, Divider<uint32_t> const &divider) {
+  return divider.divmod(dividend);
+}
+
+inline void divmod(const uint32_t *in, uint32_t *quotient, uint32_t *remainder, size_t n, Divider<uint32_t> const &divider) {
+  dispatch().u32.divmod_batch(in, quotient, remainder, n, divider);
+}
+
+inline void divmod(const uint32_t *in, uint32_t *quotient, uint32_t *remainder, size_t n, uint32_t divisor) {
+  divmod(in, quotient, remainder, n, Divider<uint32_t>(divisor));
+}
+
+// dividend % divisor == 0 via the inverse of the divisor's odd part and a rotate
+inline bool is_divisible(uint32_t dividend, uint32_t divisor) {
+  auto const dm = get_unsigned_divisibility_magic(divisor);
+  return rotate_right(static_cast<uint32_t>(dividend * dm.inverse), dm.shift) <= dm.limit;
+}
+
+inline bool is_divisible(uint32_t dividend, DivisibilityTester<uint32_t> const &tester) {
+  return tester.is_divisible(dividend);
+}
+
+} // namespace u32div
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cache.h"
+#include "dispatch.h"
+#include "divider.h"
+#include "magic.h"
+#include "stats.h"
+
+// =============================================================================
+// u64div namespace
+// =============================================================================
+
+namespace u64div {
+
+inline uint64_t opt_cal(uint64_t dividend, uint64_t divisor) {
+  if (divisor == 1) {
+    DIVTOMULTI_STATS_COUNT(One, divisor);
+    return dividend;
+  }
+
+  // For large divisors (> UINT64_MAX/2), quotient can only be 0 or 1
+  if (divisor > (static_cast<uint64_t>(-1) >> 1)) {
+    DIVTOMULTI_STATS_COUNT(Large, divisor);
+    return dividend >= divisor ? 1 : 0;
+  }
+
+  auto const dm = get_unsigned_magic_fast(divisor);
+
+  uint64_t const high = umulh(dividend, dm.magic);
+
+  if (!dm.is_add) {
+    DIVTOMULTI_STATS_COUNT(MulShift, divisor);
+    // Simple case: just shift
+    return high >> dm.shift;
+  } else {
+    // Correction case: (high + ((dividend - high) >> 1)) >> shift
+    DIVTOMULTI_STATS_COUNT(MulAddShift, divisor);
+    uint64_t const t = dividend - high;
+    return (high + (t >> 1)) >> dm.shift;
+  }
+}
+
+inline uint64_t normal_cal(uint64_t dividend, uint64_t divisor) {
+  return dividend / divisor;
+}
+
+inline uint64_t opt_rem(uint64_t dividend, uint64_t divisor) {
+  uint64_t quotient = opt_cal(dividend, divisor);
+  return dividend - divisor * quotient;
+}
+
+inline uint64_t normal_rem(uint64_t dividend, uint64_t divisor) {
+  return dividend % divisor;
+}
+
+// opt_cal with the magic number looked up in (or added to) a DividerCache,
+// for runtime divisors that repeat
+inline uint64_t opt_cal_cached(uint64_t dividend, uint64_t divisor, DividerCache<uint64_t> &cache = default_divider_cache<uint64_t>()) {
+  return cache.get(divisor).divide(dividend);
+}
+
+inline uint64_t opt_rem_cached(uint64_t dividend, uint64_t divisor, DividerCache<uint64_t> &cache = default_divider_cache<uint64_t>()) {
+  return cache.get(divisor).remainder(dividend);
+}
+
+inline void divide(const uint64_t *in, uint64_t *out, size_t n, Divider<uint64_t> const &divider) {
+  dispatch().u64.divide_batch(in, out, n, divider);
+}
+
+inline void divide(const uint64_t *in, uint64_t *out, size_t n, uint64_t divisor) {
+  divide(in, out, n, Divider<uint64_t>(divisor));
+}
+
+inline void remainder(const uint64_t *in, uint64_t *out, size_t n, Divider<uint64_t> const &divider) {
+  dispatch().u64.remainder_batch(in, out, n, divider);
+}
+
+inline void remainder(const uint64_t *in, uint64_t *out, size_t n, uint64_t divisor) {
+  remainder(in, out, n, Divider<uint64_t>(divisor));
+}
+
+// Quotient and remainder from one multiply-high; opt_rem would recompute the quotient
+inline DivMod<uint64_t> divmod(uint64_t dividend, uint64_t divisor) {
+  uint64_t const quotient = opt_cal(dividend, divisor);
+  return {quotient, dividend - divisor * quotient};
+}
+
+inline DivMod<uint64_t> divmod(uint64_t dividend, Divider<uint64_t> const &divider) {
+  return divider.divmod(dividend);
+}
+
+inline void divmod(const uint64_t *in, uint64_t *quotient, uint64_t *remainder, size_t n, Divider<uint64_t> const &divider) {
+  dispatch().u64.divmod_batch(in, quotient, remainder, n, divider);
+}
+
+inline void divmod(const uint64_t *in, uint64_t *quotient, uint64_t *remainder, size_t n, uint64_t divisor) {
+  divmod(in, quotient, remainder, n, Divider<uint64_t>(divisor));
+}
+
+// dividend % divisor == 0 via the inverse of the divisor's odd part and a rotate
+inline bool is_divisible(uint64_t dividend, uint64_t divisor) {
+  auto const dm = get_unsigned_divisibility_magic(divisor);
+  return rotate_right(static_cast<uint64_t>(dividend * dm.inverse), dm.shift) <= dm.limit;
+}
+
+inline bool is_divisible(uint64_t dividend, DivisibilityTester<uint64_t> const &tester) {
+  return tester.is_divisible(dividend);
+}
+
+} // namespace u64div
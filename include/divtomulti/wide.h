@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "intrinsics.h"
+
+// =============================================================================
+// 128-bit dividends
+// =============================================================================
+
+// 128-bit dividend divided by a 64-bit divisor without the __udivti3 library
+// call. The divisor is normalized so its top bit is set and one reciprocal is
+// computed up front, with one 128-by-64 division; every 64-bit quotient word
+// then costs a single 2-by-1 step (Moller, Granlund: "Improved division by
+// invariant integers", algorithm 4, GMP's udiv_qrnnd_preinv).
+template <typename IntType> class WideDivider;
+
+template <> class WideDivider<uint64_t> {
+public:
+  explicit WideDivider(uint64_t divisor)
+      : divisor_(divisor), shift_(divisor == 0 ? 0U : static_cast<unsigned>(clzll(divisor))), normalized_(divisor << shift_) {
+    assert(divisor != 0 && "Divisor must not be 0");
+
+    // v = floor((2^128 - 1) / d) - 2^64, which fits in 64 bits because d >= 2^63
+    reciprocal_ = static_cast<uint64_t>(((static_cast<uint128>(~normalized_) << 64) | ~static_cast<uint64_t>(0)) / normalized_);
+  }
+
+  uint128 divide(uint128 dividend, uint64_t &remainder) const {
+    uint64_t const hi = static_cast<uint64_t>(dividend >> 64);
+    uint64_t const lo = static_cast<uint64_t>(dividend);
+
+    // Shift the dividend by the same amount as the divisor, spilling into a third word
+    uint64_t const n2 = shift_ == 0 ? 0 : hi >> (64 - shift_);
+    uint64_t const n1 = shift_ == 0 ? hi : (hi << shift_) | (lo >> (64 - shift_));
+    uint64_t const n0 = lo << shift_;
+
+    uint64_t r = 0;
+    uint64_t const q_hi = divide_2by1(n2, n1, r);
+    uint64_t const q_lo = divide_2by1(r, n0, r);
+    remainder = r >> shift_;
+    return (static_cast<uint128>(q_hi) << 64) | q_lo;
+  }
+
+  uint128 divide(uint128 dividend) const {
+    uint64_t remainder = 0;
+    return divide(dividend, remainder);
+  }
+
+  uint64_t remainder(uint128 dividend) const {
+    uint64_t remainder = 0;
+    divide(dividend, remainder);
+    return remainder;
+  }
+
+  // (high:low) % divisor for high < divisor, e.g. a product of two residues:
+  // the quotient fits in 64 bits, so one 2-by-1 step is enough
+  uint64_t remainder(uint64_t high, uint64_t low) const {
+    assert(high < divisor_ && "Quotient must fit in 64 bits");
+    uint64_t const n1 = shift_ == 0 ? high : (high << shift_) | (low >> (64 - shift_));
+    uint64_t remainder = 0;
+    divide_2by1(n1, low << shift_, remainder);
+    return remainder >> shift_;
+  }
+
+  // Multi-limb dividend, least significant limb first, as in GMP's mpn
+  // functions. Quotient limbs go to out, which may alias in; the remainder is
+  // returned. carry is the remainder of the more significant limbs (below the
+  // divisor), so a long number can be streamed through in pieces, top piece
+  // first. The remainder stays shifted left by shift() from limb to limb and
+  // is shifted back once, so each limb is one 2-by-1 step.
+  uint64_t divide_limbs(const uint64_t *in, uint64_t *out, size_t n, uint64_t carry = 0) const {
+    assert(carry < divisor_ && "Carry must be below the divisor");
+    uint64_t r = carry << shift_;
+    for (size_t i = n; i-- > 0;) {
+      uint64_t const limb = in[i];
+      out[i] = divide_2by1(r | spill(limb), limb << shift_, r);
+    }
+    return r >> shift_;
+  }
+
+  // Remainder only. Without quotients there is no need to reduce every limb:
+  // a two-limb residue (h:l) is carried and the next limb a is folded in as
+  // (l:a) + h * (2^128 mod d), which is congruent to (h:l) * 2^64 + a. A
+  // carry out of 128 bits is worth 2^128 mod d again and cannot carry twice.
+  // The loop-carried chain is one multiply and an add instead of a 2-by-1
+  // step; the residue is reduced once at the end (GMP's mpn_mod_1_1p).
+  uint64_t remainder_limbs(const uint64_t *in, size_t n, uint64_t carry = 0) const {
+    assert(carry < divisor_ && "Carry must be below the divisor");
+    uint64_t const b2 = remainder(static_cast<uint128>(remainder(static_cast<uint128>(1) << 64)) << 64);
+    uint128 residue = carry;
+    for (size_t i = n; i-- > 0;) {
+      uint128 const folded = static_cast<uint128>(static_cast<uint64_t>(residue >> 64)) * b2;
+      uint128 sum = ((residue << 64) | in[i]) + folded;
+      if (sum < folded) {
+        sum += b2;
+      }
+      residue = sum;
+    }
+    return remainder(residue);
+  }
+
+  uint64_t divisor() const {
+    return divisor_;
+  }
+  uint64_t reciprocal() const {
+    return reciprocal_;
+  }
+  unsigned shift() const {
+    return shift_;
+  }
+
+private:
+  // The top shift_ bits of a limb, which move into the word above when it is normalized
+  uint64_t spill(uint64_t limb) const {
+    return shift_ == 0 ? 0 : limb >> (64 - shift_);
+  }
+
+  // (high:low) / normalized_ for high < normalized_; the estimate from the
+  // reciprocal is at most one too large or one too small
+  uint64_t divide_2by1(uint64_t high, uint64_t low, uint64_t &remainder) const {
+    uint128 const estimate = static_cast<uint128>(reciprocal_) * high + ((static_cast<uint128>(high) << 64) | low);
+    uint64_t q = static_cast<uint64_t>(estimate >> 64) + 1;
+    uint64_t r = low - q * normalized_;
+    if (r > static_cast<uint64_t>(estimate)) {
+      --q;
+      r += normalized_;
+    }
+    if (r >= normalized_) {
+      ++q;
+      r -= normalized_;
+    }
+    remainder = r;
+    return q;
+  }
+
+  uint64_t divisor_;
+  unsigned shift_;
+  uint64_t normalized_;
+  uint64_t reciprocal_;
+};
+
+// Free forms of the limb streaming above, shaped like the batch divide() overloads
+inline uint64_t divide_limbs(const uint64_t *in, uint64_t *out, size_t n, WideDivider<uint64_t> const &divider, uint64_t carry = 0) {
+  return divider.divide_limbs(in, out, n, carry);
+}
+
+inline uint64_t remainder_limbs(const uint64_t *in, size_t n, WideDivider<uint64_t> const &divider, uint64_t carry = 0) {
+  return divider.remainder_limbs(in, n, carry);
+}
+
+// Signed 128-bit dividend by a signed 64-bit divisor, truncating toward zero.
+// Works on magnitudes, so INT128_MIN / -1 wraps to INT128_MIN like opt_cal_signed.
+template <> class WideDivider<int64_t> {
+public:
+  explicit WideDivider(int64_t divisor)
+      : divisor_(divisor), unsigned_(divisor < 0 ? 0U - static_cast<uint64_t>(divisor) : static_cast<uint64_t>(divisor)) {
+  }
+
+  int128 divide(int128 dividend, int64_t &remainder) const {
+    uint128 const sign = dividend < 0 ? ~static_cast<uint128>(0) : 0;
+    uint128 const abs_dividend = (static_cast<uint128>(dividend) ^ sign) - sign;
+
+    uint64_t abs_remainder = 0;
+    uint128 const abs_quotient = unsigned_.divide(abs_dividend, abs_remainder);
+
+    // The remainder takes the dividend's sign, the quotient the xor of both signs
+    uint64_t const r_sign = static_cast<uint64_t>(sign);
+    remainder = static_cast<int64_t>((abs_remainder ^ r_sign) - r_sign);
+    uint128 const q_sign = divisor_ < 0 ? ~sign : sign;
+    return static_cast<int128>((abs_quotient ^ q_sign) - q_sign);
+  }
+
+  int128 divide(int128 dividend) const {
+    int64_t remainder = 0;
+    return divide(dividend, remainder);
+  }
+
+  int64_t remainder(int128 dividend) const {
+    int64_t remainder = 0;
+    divide(dividend, remainder);
+    return remainder;
+  }
+
+  int64_t divisor() const {
+    return divisor_;
+  }
+  uint64_t reciprocal() const {
+    return unsigned_.reciprocal();
+  }
+  unsigned shift() const {
+    return unsigned_.shift();
+  }
+
+private:
+  int64_t divisor_;
+  WideDivider<uint64_t> unsigned_;
+};
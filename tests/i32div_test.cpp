@@ -0,0 +1,675 @@
+#include "tests.h"
+
+namespace i32div {
+
+void test_div() {
+  int32_t const min_val = -(1 << (T - 1));
+  int32_t const max_val = (1 << (T - 1)) - 1;
+
+  for (int32_t dividend = min_val; dividend <= max_val; ++dividend) {
+    report::progress("i32div div", static_cast<uint64_t>(dividend - min_val));
+    for (int32_t divisor = min_val; divisor <= max_val; ++divisor) {
+      if (divisor == 0)
+        continue;
+
+      int32_t const result = i32div::opt_cal_signed(dividend, divisor);
+      int32_t const expected = i32div::normal_cal(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("i32div div", dividend, "/", divisor, result, expected);
+      }
+    }
+  }
+
+  report::finish("i32div div");
+}
+
+void test_rem() {
+  int32_t const min_val = -(1 << (T - 1));
+  int32_t const max_val = (1 << (T - 1)) - 1;
+
+  for (int32_t dividend = min_val; dividend <= max_val; ++dividend) {
+    report::progress("i32div rem", static_cast<uint64_t>(dividend - min_val));
+    for (int32_t divisor = min_val; divisor <= max_val; ++divisor) {
+      if (divisor == 0)
+        continue;
+
+      int32_t const result = i32div::opt_rem_signed(dividend, divisor);
+      int32_t const expected = i32div::normal_rem(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("i32div rem", dividend, "%", divisor, result, expected);
+      }
+    }
+  }
+
+  report::finish("i32div rem");
+}
+void test_divider() {
+  int32_t const min_val = -(1 << (T - 1));
+  int32_t const max_val = (1 << (T - 1)) - 1;
+
+  for (int32_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i32div divider", static_cast<uint64_t>(divisor - min_val));
+    Divider<int32_t> const divider(divisor);
+    for (int32_t dividend = min_val; dividend <= max_val; ++dividend) {
+      int32_t const result = divider.divide(dividend);
+      int32_t const expected = i32div::normal_cal(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("i32div divider", dividend, "/", divisor, result, expected);
+      }
+      int32_t const rem_result = divider.remainder(dividend);
+      int32_t const rem_expected = i32div::normal_rem(dividend, divisor);
+      if (rem_result != rem_expected) {
+        report::mismatch("i32div divider", dividend, "%", divisor, rem_result, rem_expected);
+      }
+    }
+  }
+
+  int32_t const test_dividends[] = {
+      INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, 0, 1, -1, INT32_MAX / 2, INT32_MIN / 2,
+  };
+
+  int32_t const test_divisors[] = {
+      INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 2 + 2, INT32_MIN / 2 - 1, 1, -1, 3, -3, 7, -7,
+  };
+
+  for (int32_t divisor : test_divisors) {
+    Divider<int32_t> const divider(divisor);
+    for (int32_t dividend : test_dividends) {
+      // Skip MIN / -1 as it's UB
+      if (dividend == INT32_MIN && divisor == -1)
+        continue;
+
+      int32_t const result = divider.divide(dividend);
+      int32_t const expected = i32div::normal_cal(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("i32div divider", dividend, "/", divisor, result, expected);
+      }
+      int32_t const rem_result = divider.remainder(dividend);
+      int32_t const rem_expected = i32div::normal_rem(dividend, divisor);
+      if (rem_result != rem_expected) {
+        report::mismatch("i32div divider", dividend, "%", divisor, rem_result, rem_expected);
+      }
+    }
+  }
+
+  report::finish("i32div divider");
+}
+void test_batch() {
+  std::mt19937 rng(2024);
+  std::vector<int32_t> input(1027);
+  std::vector<int32_t> output(input.size());
+
+  for (auto &value : input) {
+    value = static_cast<int32_t>(rng());
+  }
+  int32_t const test_dividends[] = {0, 1, -1, 2, -2, 100, -100, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 2, INT32_MIN / 2};
+  size_t k = 0;
+  for (int32_t dividend : test_dividends) {
+    input[k++] = dividend;
+  }
+
+  std::vector<int32_t> test_divisors = {1, -1, 2, -2, 3, -3, 7, -7, 1000, -1000, 1 << 20, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 2 + 2, INT32_MIN / 2 - 1};
+  while (test_divisors.size() < 32) {
+    int32_t const divisor = static_cast<int32_t>(rng() >> (rng() % (sizeof(int32_t) * 8)));
+    if (divisor != 0) {
+      test_divisors.push_back(divisor);
+    }
+  }
+
+  std::vector<int32_t> remainders(input.size());
+  for (DispatchTier tier : {DispatchTier::Scalar, DispatchTier::BMI2, DispatchTier::SSE41, DispatchTier::AVX2, DispatchTier::AVX512, DispatchTier::NEON}) {
+    if (!force_dispatch_tier(tier)) {
+      continue;
+    }
+    for (int32_t divisor : test_divisors) {
+      Divider<int32_t> const divider(divisor);
+      divide(input.data(), output.data(), input.size(), divider);
+      remainder(input.data(), remainders.data(), input.size(), divider);
+      for (size_t i = 0; i < input.size(); ++i) {
+        // MIN / -1 wraps, like opt_cal_signed
+        int32_t const expected = input[i] == INT32_MIN && divisor == -1 ? INT32_MIN : i32div::normal_cal(input[i], divisor);
+        if (output[i] != expected) {
+          report::mismatch("i32div batch", input[i], report::tier_op("/", tier).c_str(), divisor, output[i], expected);
+        }
+        if (dispatch().i32.divide(input[i], divider) != expected) {
+          report::mismatch("i32div batch", input[i], report::tier_op("/ (scalar kernel)", tier).c_str(), divisor,
+                           dispatch().i32.divide(input[i], divider), expected);
+        }
+        int32_t const rem_expected = input[i] == INT32_MIN && divisor == -1 ? 0 : i32div::normal_rem(input[i], divisor);
+        if (remainders[i] != rem_expected) {
+          report::mismatch("i32div batch", input[i], report::tier_op("%", tier).c_str(), divisor, remainders[i], rem_expected);
+        }
+      }
+    }
+  }
+  reset_dispatch_tier();
+
+  report::finish("i32div batch");
+}
+template <int32_t D> void check_const_divider_at(int32_t dividend) {
+    // Skip MIN / -1 as it's UB
+    if (dividend == INT32_MIN && D == -1)
+      return;
+  int32_t const result = ConstDivider<int32_t, D>::divide(dividend);
+  int32_t const expected = i32div::normal_cal(dividend, D);
+  if (result != expected) {
+    std::cout << "Error: " << dividend << " / " << D << " = " << result << " instead " << expected << std::endl;
+    std::terminate();
+  }
+  int32_t const rem_result = ConstDivider<int32_t, D>::remainder(dividend);
+  int32_t const rem_expected = i32div::normal_rem(dividend, D);
+  if (rem_result != rem_expected) {
+    std::cout << "Error: " << dividend << " % " << D << " = " << rem_result << " instead " << rem_expected << std::endl;
+    std::terminate();
+  }
+  if (ConstDivider<int32_t, D>::is_divisible(dividend) != (rem_expected == 0)) {
+    std::cout << "Error: " << dividend << " divisible by " << D << " should be " << (rem_expected == 0) << std::endl;
+    std::terminate();
+  }  DivMod<int32_t> const qr = ConstDivider<int32_t, D>::divmod(dividend);
+  if (qr.quotient != expected || qr.remainder != rem_expected) {
+    std::cout << "Error: divmod(" << dividend << ", " << D << ") = {" << qr.quotient << ", " << qr.remainder << "}" << std::endl;
+    std::terminate();
+  }
+}
+
+template <int32_t D> void check_const_divider() {
+  for (int32_t dividend = -(static_cast<int32_t>(1) << (T - 1)); dividend <= (static_cast<int32_t>(1) << (T - 1)) - 1; ++dividend) {
+    check_const_divider_at<D>(dividend);
+  }
+  int32_t const test_dividends[] = {0, 1, -1, 100, -100, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 2, INT32_MIN / 2};
+  for (int32_t dividend : test_dividends) {
+    check_const_divider_at<D>(dividend);
+  }
+}
+
+void test_const_divider() {
+  check_const_divider<1>();
+  check_const_divider<-1>();
+  check_const_divider<2>();
+  check_const_divider<-2>();
+  check_const_divider<3>();
+  check_const_divider<-3>();
+  check_const_divider<7>();
+  check_const_divider<-7>();
+  check_const_divider<199>();
+  check_const_divider<-199>();
+  check_const_divider<1000>();
+  check_const_divider<86400>();
+  check_const_divider<-86400>();
+  check_const_divider<4096>();
+  check_const_divider<INT32_MAX>();
+  check_const_divider<INT32_MIN>();
+  check_const_divider<INT32_MIN + 1>();
+  check_const_divider<INT32_MAX / 2 + 2>();
+
+  std::cout << "i32div const divider tests passed!" << std::endl;
+}
+void test_fast_mod() {
+  int32_t const min_val = -(1 << (T - 1));
+  int32_t const max_val = (1 << (T - 1)) - 1;
+
+  for (int32_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i32div fastmod", static_cast<uint64_t>(divisor - min_val));
+    FastMod<int32_t> const fast_mod(divisor);
+    for (int32_t dividend = min_val; dividend <= max_val; ++dividend) {
+      int32_t const result = fast_mod.remainder(dividend);
+      int32_t const expected = i32div::normal_rem(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("i32div fastmod", dividend, "%", divisor, result, expected);
+      }
+    }
+  }
+
+  int32_t const test_dividends[] = {0, 1, -1, 100, -100, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 2, INT32_MIN / 2};
+  int32_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 7, -7, 1 << 30, -(1 << 30), INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1};
+
+  for (int32_t divisor : test_divisors) {
+    FastMod<int32_t> const fast_mod(divisor);
+    for (int32_t dividend : test_dividends) {
+      // MIN % -1 is UB for the built-in operator; fastmod gives 0
+      if (dividend == INT32_MIN && divisor == -1)
+        continue;
+      int32_t const result = fast_mod.remainder(dividend);
+      int32_t const expected = i32div::normal_rem(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("i32div fastmod", dividend, "%", divisor, result, expected);
+      }
+    }
+  }
+
+  report::finish("i32div fastmod");
+}
+void test_is_divisible() {
+  int32_t const min_val = -(1 << (T - 1));
+  int32_t const max_val = (1 << (T - 1)) - 1;
+
+  for (int32_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i32div divisibility", static_cast<uint64_t>(divisor - min_val));
+    DivisibilityTester<int32_t> const tester(divisor);
+    for (int32_t dividend = min_val; dividend <= max_val; ++dividend) {
+      // MIN % -1 is UB for the built-in operator, but every integer is divisible by -1
+      bool const expected = divisor == -1 || i32div::normal_rem(dividend, divisor) == 0;
+      if (tester.is_divisible(dividend) != expected || is_divisible(dividend, divisor) != expected) {
+        report::mismatch("i32div divisibility", dividend, "divisible by", divisor, !expected, expected);
+      }
+    }
+  }
+
+  int32_t const test_dividends[] = {0, 1, -1, 2, -2, 100, -100, 641, -641, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 3, INT32_MIN / 2};
+  int32_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 6, -6, 7, -7, 641, -641, 1 << 30, -(1 << 30), INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 3};
+
+  for (int32_t divisor : test_divisors) {
+    DivisibilityTester<int32_t> const tester(divisor);
+    for (int32_t dividend : test_dividends) {
+      // MIN % -1 is UB for the built-in operator, but every integer is divisible by -1
+      bool const expected = divisor == -1 || i32div::normal_rem(dividend, divisor) == 0;
+      if (tester.is_divisible(dividend) != expected || is_divisible(dividend, divisor) != expected) {
+        report::mismatch("i32div divisibility", dividend, "divisible by", divisor, !expected, expected);
+      }
+    }
+  }
+
+  report::finish("i32div divisibility");
+}
+void test_divider_cache() {
+  int32_t const min_val = -(1 << (T - 1));
+  int32_t const max_val = (1 << (T - 1)) - 1;
+
+  // 64 slots for 4095 divisors: every divisor is inserted once and most of them are evicted again
+  DividerCache<int32_t> cache(64);
+  uint64_t lookups = 0;
+  for (int32_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i32div divider cache", static_cast<uint64_t>(divisor - min_val));
+    for (int32_t dividend = min_val; dividend <= max_val; ++dividend) {
+      int32_t const quotient = opt_cal_signed_cached(dividend, divisor, cache);
+      int32_t const remainder = opt_rem_signed_cached(dividend, divisor, cache);
+      lookups += 2;
+      if (quotient != normal_cal(dividend, divisor)) {
+        report::mismatch("i32div divider cache", dividend, "/", divisor, quotient, normal_cal(dividend, divisor));
+      }
+      if (remainder != normal_rem(dividend, divisor)) {
+        report::mismatch("i32div divider cache", dividend, "%", divisor, remainder, normal_rem(dividend, divisor));
+      }
+    }
+  }
+  DividerCacheStats stats = cache.stats();
+  if (stats.hits + stats.misses != lookups) {
+    report::mismatch("i32div divider cache", "hits + misses", "of", "sweep", stats.hits + stats.misses, lookups);
+  }
+  if (stats.misses < static_cast<uint64_t>((1ULL << T) - 1)) {
+    report::mismatch("i32div divider cache", "misses", "of", "sweep", stats.misses, "one per divisor or more");
+  }
+  if (stats.evictions == 0) {
+    report::mismatch("i32div divider cache", "evictions", "of", "sweep", stats.evictions, "some");
+  }
+
+  int32_t const test_dividends[] = {0, 1, -1, 100, -100, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 2, INT32_MIN / 2};
+  int32_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 7, -7, 1 << 30, -(1 << 30), INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1};
+
+  // Plenty of room: the second pass must hit for every divisor
+  DividerCache<int32_t> edge_cache(1024);
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int32_t divisor : test_divisors) {
+      for (int32_t dividend : test_dividends) {
+        int32_t const quotient = opt_cal_signed_cached(dividend, divisor, edge_cache);
+        int32_t const remainder = opt_rem_signed_cached(dividend, divisor, edge_cache);
+        if (quotient != opt_cal_signed(dividend, divisor)) {
+          report::mismatch("i32div divider cache", dividend, "/", divisor, quotient, opt_cal_signed(dividend, divisor));
+        }
+        if (remainder != opt_rem_signed(dividend, divisor)) {
+          report::mismatch("i32div divider cache", dividend, "%", divisor, remainder, opt_rem_signed(dividend, divisor));
+        }
+      }
+    }
+  }
+  stats = edge_cache.stats();
+  if (stats.misses != sizeof(test_divisors) / sizeof(test_divisors[0])) {
+    report::mismatch("i32div divider cache", "misses", "of", "edge cache", stats.misses, sizeof(test_divisors) / sizeof(test_divisors[0]));
+  }
+  if (stats.evictions != 0) {
+    report::mismatch("i32div divider cache", "evictions", "of", "edge cache", stats.evictions, 0);
+  }
+
+  report::finish("i32div divider cache");
+}
+void test_branchfree_divider() {
+  int32_t const min_val = -(1 << (T - 1));
+  int32_t const max_val = (1 << (T - 1)) - 1;
+
+  for (int32_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i32div branchfree divider", static_cast<uint64_t>(divisor - min_val));
+    BranchfreeDivider<int32_t> const divider(divisor);
+    for (int32_t dividend = min_val; dividend <= max_val; ++dividend) {
+      if (divider.divide(dividend) != normal_cal(dividend, divisor)) {
+        report::mismatch("i32div branchfree divider", dividend, "/", divisor, divider.divide(dividend), normal_cal(dividend, divisor));
+      }
+      if (divider.remainder(dividend) != normal_rem(dividend, divisor)) {
+        report::mismatch("i32div branchfree divider", dividend, "%", divisor, divider.remainder(dividend), normal_rem(dividend, divisor));
+      }
+    }
+  }
+
+  // Every case the branchy path special-cases: +-1, MIN, powers of two, large divisors, magic overflow
+  int32_t const test_dividends[] = {0, 1, -1, 100, -100, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 2, INT32_MIN / 2};
+  int32_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 7, -7, 1 << 30, -(1 << 30), (1 << 30) + 1, -(1 << 30) - 1, INT32_MAX, INT32_MAX - 1, INT32_MAX / 2 + 2,
+                               INT32_MIN / 2 - 1, INT32_MIN, INT32_MIN + 1};
+  for (int32_t divisor : test_divisors) {
+    BranchfreeDivider<int32_t> const divider(divisor);
+    for (int32_t dividend : test_dividends) {
+      // MIN / -1 wraps like opt_cal_signed
+      int32_t const expected = dividend == INT32_MIN && divisor == -1 ? INT32_MIN : normal_cal(dividend, divisor);
+      int32_t const expected_rem = dividend == INT32_MIN && divisor == -1 ? 0 : normal_rem(dividend, divisor);
+      if (divider.divide(dividend) != expected) {
+        report::mismatch("i32div branchfree divider", dividend, "/", divisor, divider.divide(dividend), expected);
+      }
+      if (divider.remainder(dividend) != expected_rem) {
+        report::mismatch("i32div branchfree divider", dividend, "%", divisor, divider.remainder(dividend), expected_rem);
+      }
+    }
+  }
+
+  report::finish("i32div branchfree divider");
+}
+void test_rounding() {
+  int32_t const min_val = -(1 << (T - 1));
+  int32_t const max_val = (1 << (T - 1)) - 1;
+
+  auto check = [](RoundingDivider<int32_t> const &divider, int32_t dividend) {
+    int32_t const divisor = divider.divisor();
+    int32_t const results[] = {
+        div_floor(dividend, divisor),  div_ceil(dividend, divisor),  div_euclid(dividend, divisor),  rem_floor(dividend, divisor),
+        rem_euclid(dividend, divisor), divider.div_floor(dividend), divider.div_ceil(dividend),     divider.div_euclid(dividend),
+        divider.rem_floor(dividend),   divider.rem_euclid(dividend),
+    };
+    int32_t const expected[] = {
+        reference_div_floor(dividend, divisor), reference_div_ceil(dividend, divisor),  reference_div_euclid(dividend, divisor),
+        reference_rem_floor(dividend, divisor), reference_rem_euclid(dividend, divisor),
+    };
+    char const *const names[] = {"div_floor", "div_ceil", "div_euclid", "rem_floor", "rem_euclid"};
+    char const *const divider_names[] = {"divider div_floor", "divider div_ceil", "divider div_euclid", "divider rem_floor", "divider rem_euclid"};
+    for (size_t i = 0; i < 10; ++i) {
+      if (results[i] != expected[i % 5]) {
+        report::mismatch("i32div rounding", dividend, i < 5 ? names[i % 5] : divider_names[i % 5], divisor, results[i], expected[i % 5]);
+      }
+    }
+  };
+
+  for (int32_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i32div rounding", static_cast<uint64_t>(divisor - min_val));
+    RoundingDivider<int32_t> const divider(divisor);
+    for (int32_t dividend = min_val; dividend <= max_val; ++dividend) {
+      check(divider, dividend);
+    }
+  }
+
+  int32_t const test_dividends[] = {0, 1, -1, 100, -100, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 2, INT32_MIN / 2};
+  int32_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 7, -7, (1 << 30), -(1 << 30), INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1};
+  for (int32_t divisor : test_divisors) {
+    RoundingDivider<int32_t> const divider(divisor);
+    for (int32_t dividend : test_dividends) {
+      // MIN / -1 is UB for the reference
+      if (dividend == INT32_MIN && divisor == -1)
+        continue;
+      check(divider, dividend);
+    }
+  }
+
+  report::finish("i32div rounding");
+}
+void test_divmod() {
+  int32_t const min_val = -(static_cast<int32_t>(1) << (T - 1));
+  int32_t const max_val = (static_cast<int32_t>(1) << (T - 1)) - 1;
+
+  for (int32_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    Divider<int32_t> const divider(divisor);
+    for (int32_t dividend = min_val; dividend <= max_val; ++dividend) {
+      // Skip MIN / -1 as it's UB
+      if (dividend == min_val && divisor == -1)
+        continue;
+      DivMod<int32_t> const qr = divmod(dividend, divisor);
+      DivMod<int32_t> const divider_qr = divmod(dividend, divider);
+      int32_t const expected = normal_cal(dividend, divisor);
+      int32_t const rem_expected = normal_rem(dividend, divisor);
+      if (qr.quotient != expected || divider_qr.quotient != expected) {
+        report::mismatch("i32div divmod", dividend, "/", divisor, qr.quotient != expected ? qr.quotient : divider_qr.quotient, expected);
+      }
+      if (qr.remainder != rem_expected || divider_qr.remainder != rem_expected) {
+        report::mismatch("i32div divmod", dividend, "%", divisor, qr.remainder != rem_expected ? qr.remainder : divider_qr.remainder, rem_expected);
+      }
+    }
+  }
+
+  // Batch form: both output arrays, on every tier, with lengths that leave a vector tail
+  std::mt19937 rng(2025);
+  std::vector<int32_t> input(1029);
+  for (auto &value : input) {
+    value = static_cast<int32_t>(rng());
+  }
+  int32_t const test_dividends[] = {0, 1, -1, 2, -2, 100, -100, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 2, INT32_MIN / 2};
+  size_t k = 0;
+  for (int32_t dividend : test_dividends) {
+    input[k++] = dividend;
+  }
+  int32_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 7, -7, 1000, -1000, 1 << 20, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 2 + 2, INT32_MIN / 2 - 1};
+
+  std::vector<int32_t> quotients(input.size());
+  std::vector<int32_t> remainders(input.size());
+  for (DispatchTier tier : {DispatchTier::Scalar, DispatchTier::BMI2, DispatchTier::SSE41, DispatchTier::AVX2, DispatchTier::AVX512, DispatchTier::NEON}) {
+    if (!force_dispatch_tier(tier)) {
+      continue;
+    }
+    for (int32_t divisor : test_divisors) {
+      divmod(input.data(), quotients.data(), remainders.data(), input.size(), divisor);
+      for (size_t i = 0; i < input.size(); ++i) {
+        if (input[i] == INT32_MIN && divisor == -1)
+          continue;
+        if (quotients[i] != normal_cal(input[i], divisor)) {
+          report::mismatch("i32div divmod", input[i], report::tier_op("/", tier).c_str(), divisor, quotients[i], normal_cal(input[i], divisor));
+        }
+        if (remainders[i] != normal_rem(input[i], divisor)) {
+          report::mismatch("i32div divmod", input[i], report::tier_op("%", tier).c_str(), divisor, remainders[i], normal_rem(input[i], divisor));
+        }
+      }
+    }
+  }
+  reset_dispatch_tier();
+
+  report::finish("i32div divmod");
+}
+void test_format() {
+  char buffer[max_decimal_chars<int32_t>() + 1];
+  auto check = [&buffer](int32_t value) {
+    std::string const result(buffer, format_decimal(value, buffer));
+    if (result != std::to_string(value)) {
+      std::cout << "Error: format_decimal(" << value << ") = \"" << result << "\"" << std::endl;
+      std::terminate();
+    }
+  };
+
+  for (int32_t value = -(static_cast<int32_t>(1) << (T - 1)); value <= (static_cast<int32_t>(1) << (T - 1)) - 1; ++value) {
+    check(value);
+  }
+  // Both sides of every digit count change, and the extremes
+  for (int32_t power = 1; power <= INT32_MAX / 10; power *= 10) {
+    check(static_cast<int32_t>(power * 10));
+    check(static_cast<int32_t>(power * 10 - 1));
+    check(static_cast<int32_t>(power * 10 + 1));
+      check(static_cast<int32_t>(-power));
+      check(static_cast<int32_t>(-power + 1));
+      check(static_cast<int32_t>(-power - 1));
+  }
+  check(INT32_MAX);
+  check(INT32_MAX - 1);
+  check(INT32_MIN);
+  check(INT32_MIN + 1);
+
+  // Batch form: one buffer, separated values
+  std::mt19937 rng(2026);
+  std::vector<int32_t> input(1000);
+  for (auto &value : input) {
+    value = static_cast<int32_t>(rng() >> (rng() % (sizeof(int32_t) * 8)));
+  }
+  std::vector<char> text(input.size() * (max_decimal_chars<int32_t>() + 1));
+  char *const end = format_decimal(input.data(), input.size(), text.data(), ',');
+  std::string expected;
+  for (int32_t value : input) {
+    expected += std::to_string(value) + ',';
+  }
+  if (std::string(text.data(), end) != expected) {
+    std::cout << "Error: batch format_decimal differs from std::to_string" << std::endl;
+    std::terminate();
+  }
+
+  std::cout << "i32div format tests passed!" << std::endl;
+}
+
+void test_jit_divider() {
+  // Scalar and batch code for every divisor in range, against the built-in operator
+  std::vector<int32_t> dividends;
+  for (int32_t dividend = static_cast<int32_t>(-(1 << (T - 1))); dividend <= static_cast<int32_t>((1 << (T - 1)) - 1); ++dividend) {
+    dividends.push_back(dividend);
+  }
+  std::vector<int32_t> quotients(dividends.size());
+  bool compiled = true;
+  for (int32_t divisor = static_cast<int32_t>(-(1 << (T - 1))); divisor <= static_cast<int32_t>((1 << (T - 1)) - 1); ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i32div jit divider", static_cast<uint64_t>(divisor - static_cast<int32_t>(-(1 << (T - 1)))));
+    JitDivider<int32_t> const divider(divisor);
+    compiled = compiled && divider.compiled();
+    divider.divide(dividends.data(), quotients.data(), dividends.size());
+    for (size_t i = 0; i < dividends.size(); ++i) {
+      int32_t const expected = normal_cal(dividends[i], divisor);
+      if (divider.divide(dividends[i]) != expected) {
+        report::mismatch("i32div jit divider", dividends[i], "/", divisor, divider.divide(dividends[i]), expected);
+      }
+      if (quotients[i] != expected) {
+        report::mismatch("i32div jit divider", dividends[i], "batch /", divisor, quotients[i], expected);
+      }
+    }
+  }
+
+  // Every strategy at the edges of the range, and the fallback, against Divider<T>
+  std::vector<int32_t> test_dividends = {0, 1, -1, 100, -100, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 2, INT32_MIN / 2};
+  std::mt19937_64 rng(2029);
+  while (test_dividends.size() < 67) {
+    test_dividends.push_back(static_cast<int32_t>(rng()));
+  }
+  std::vector<int32_t> out(test_dividends.size());
+  int32_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 7, -7, 1 << 30, -(1 << 30), (1 << 30) + 1, -(1 << 30) - 1, INT32_MAX, INT32_MAX - 1, INT32_MAX / 2 + 2, INT32_MIN / 2 - 1, INT32_MIN, INT32_MIN + 1};
+  for (int32_t divisor : test_divisors) {
+    Divider<int32_t> const reference(divisor);
+    for (bool allow_jit : {true, false}) {
+      JitDivider<int32_t> const divider(divisor, allow_jit);
+      if (!allow_jit && divider.compiled()) {
+        report::mismatch("i32div jit divider", "any", "/ (JIT disabled)", divisor, "compiled", "fallback");
+      }
+      divider.divide(test_dividends.data(), out.data(), test_dividends.size());
+      for (size_t i = 0; i < test_dividends.size(); ++i) {
+        int32_t const expected = reference.divide(test_dividends[i]);
+        if (divider.divide(test_dividends[i]) != expected || out[i] != expected) {
+          report::mismatch("i32div jit divider", test_dividends[i], allow_jit ? "/" : "fallback /", divisor, divider.divide(test_dividends[i]),
+                           expected);
+        }
+      }
+    }
+  }
+  if (!compiled) {
+    std::cout << "i32div jit divider: executable pages unavailable, checked the fallback only\n";
+  }
+
+  report::finish("i32div jit divider");
+}
+
+void test_float_divider() {
+  std::vector<int32_t> dividends;
+  for (int32_t dividend = static_cast<int32_t>(-(1 << (T - 1))); dividend <= static_cast<int32_t>((1 << (T - 1)) - 1); ++dividend) {
+    dividends.push_back(dividend);
+  }
+  std::vector<int32_t> quotients(dividends.size());
+  std::vector<int32_t> remainders(dividends.size());
+  for (int32_t divisor = static_cast<int32_t>(-(1 << (T - 1))); divisor <= static_cast<int32_t>((1 << (T - 1)) - 1); ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i32div float divider", static_cast<uint64_t>(divisor - static_cast<int32_t>(-(1 << (T - 1)))));
+    FloatDivider<int32_t> const divider(divisor);
+    divide(dividends.data(), quotients.data(), dividends.size(), divider);
+    remainder(dividends.data(), remainders.data(), dividends.size(), divider);
+    for (size_t i = 0; i < dividends.size(); ++i) {
+      int32_t const dividend = dividends[i];
+      int32_t const expected = normal_cal(dividend, divisor);
+      int32_t const expected_rem = normal_rem(dividend, divisor);
+      if (divider.divide(dividend) != expected || quotients[i] != expected) {
+        report::mismatch("i32div float divider", dividend, "/", divisor, quotients[i], expected);
+      }
+      if (divider.remainder(dividend) != expected_rem || remainders[i] != expected_rem) {
+        report::mismatch("i32div float divider", dividend, "%", divisor, remainders[i], expected_rem);
+      }
+    }
+  }
+
+  // Edge divisors and dividends through every tier's batch path, against Divider<T>
+  std::vector<int32_t> test_dividends = {0, 1, -1, 100, -100, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1, INT32_MAX / 2, INT32_MIN / 2};
+  std::mt19937 rng(2030);
+  while (test_dividends.size() < 1027) {
+    test_dividends.push_back(static_cast<int32_t>(rng()));
+  }
+  int32_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 7, -7, 1 << 30, -(1 << 30), (1 << 30) + 1, -(1 << 30) - 1, INT32_MAX, INT32_MAX - 1, INT32_MIN, INT32_MIN + 1};
+  std::vector<int32_t> out(test_dividends.size());
+  std::vector<int32_t> out_rem(test_dividends.size());
+  for (int32_t divisor : test_divisors) {
+    Divider<int32_t> const reference(divisor);
+    FloatDivider<int32_t> const divider(divisor);
+    for (DispatchTier tier : {DispatchTier::Scalar, DispatchTier::AVX2, DispatchTier::AVX512}) {
+      if (!force_dispatch_tier(tier)) {
+        continue;
+      }
+      divide(test_dividends.data(), out.data(), test_dividends.size(), divider);
+      remainder(test_dividends.data(), out_rem.data(), test_dividends.size(), divider);
+      for (size_t i = 0; i < test_dividends.size(); ++i) {
+        int32_t const dividend = test_dividends[i];
+        if (out[i] != reference.divide(dividend) || divider.divide(dividend) != reference.divide(dividend)) {
+          report::mismatch("i32div float divider", dividend, "/", divisor, out[i], reference.divide(dividend));
+        }
+        if (out_rem[i] != reference.remainder(dividend) || divider.remainder(dividend) != reference.remainder(dividend)) {
+          report::mismatch("i32div float divider", dividend, "%", divisor, out_rem[i], reference.remainder(dividend));
+        }
+      }
+    }
+    reset_dispatch_tier();
+  }
+
+  report::finish("i32div float divider");
+}
+
+void test_stats() {
+  using stats::DivPath;
+  std::vector<StatsCase<int32_t>> const cases = {
+      {INT32_MIN, -1, DivPath::Overflow, false},
+      {100, 1, DivPath::One, false},
+      {100, -1, DivPath::MinusOne, false},
+      {-100, 8, DivPath::Pow2, false},
+      {-100, -8, DivPath::Pow2, false},
+      {100, (1 << 30) + 1, DivPath::Large, false},
+      {100, 10, DivPath::MulShift, false},
+      {100, -10, DivPath::MulShift, true},
+      {100, 7, DivPath::MulAddShift, true},
+      {-100, 7, DivPath::MulAddShift, true}};
+  check_stats<int32_t>("i32div stats", [](int32_t dividend, int32_t divisor) { return opt_cal_signed(dividend, divisor); }, cases);
+}
+
+} // namespace i32div
@@ -0,0 +1,663 @@
+#include "tests.h"
+
+namespace i64div {
+
+void test_div() {
+  int64_t const min_val = -(1LL << (T - 1));
+  int64_t const max_val = (1LL << (T - 1)) - 1;
+
+  for (int64_t dividend = min_val; dividend <= max_val; ++dividend) {
+    report::progress("i64div div", static_cast<uint64_t>(dividend - min_val));
+    for (int64_t divisor = min_val; divisor <= max_val; ++divisor) {
+      if (divisor == 0)
+        continue;
+
+      int64_t const result = i64div::opt_cal_signed(dividend, divisor);
+      int64_t const expected = i64div::normal_cal(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("i64div div", dividend, "/", divisor, result, expected);
+      }
+    }
+  }
+
+  report::finish("i64div div");
+}
+
+void test_rem() {
+  int64_t const min_val = -(1LL << (T - 1));
+  int64_t const max_val = (1LL << (T - 1)) - 1;
+
+  for (int64_t dividend = min_val; dividend <= max_val; ++dividend) {
+    report::progress("i64div rem", static_cast<uint64_t>(dividend - min_val));
+    for (int64_t divisor = min_val; divisor <= max_val; ++divisor) {
+      if (divisor == 0)
+        continue;
+
+      int64_t const result = i64div::opt_rem_signed(dividend, divisor);
+      int64_t const expected = i64div::normal_rem(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("i64div rem", dividend, "%", divisor, result, expected);
+      }
+    }
+  }
+
+  report::finish("i64div rem");
+}
+
+void test_overflow_cases() {
+  int64_t const max_val = INT64_MAX;
+  int64_t const min_val = INT64_MIN;
+
+  std::cout << "Testing i64div overflow cases..." << std::endl;
+
+  int64_t const test_dividends[] = {
+      max_val, max_val - 1, min_val, min_val + 1, 0, 1, -1, max_val / 2, min_val / 2,
+  };
+
+  int64_t const test_divisors[] = {
+      max_val, max_val - 1, min_val, min_val + 1, 1, -1, 3, -3, 7, -7,
+  };
+
+  for (int64_t dividend : test_dividends) {
+    for (int64_t divisor : test_divisors) {
+      if (divisor == 0)
+        continue;
+      // Skip INT64_MIN / -1 as it's UB
+      if (dividend == min_val && divisor == -1)
+        continue;
+
+      int64_t const result = opt_cal_signed(dividend, divisor);
+      int64_t const expected = normal_cal(dividend, divisor);
+      if (result != expected) {
+        std::cout << "Error: " << dividend << " / " << divisor << " = " << result << " instead " << expected << std::endl;
+        std::terminate();
+      }
+
+      int64_t const rem_result = opt_rem_signed(dividend, divisor);
+      int64_t const rem_expected = normal_rem(dividend, divisor);
+      if (rem_result != rem_expected) {
+        std::cout << "Error: " << dividend << " % " << divisor << " = " << rem_result << " instead " << rem_expected << std::endl;
+        std::terminate();
+      }
+    }
+  }
+
+  std::cout << "i64div overflow tests passed!" << std::endl;
+}
+
+void test_divider() {
+  int64_t const min_val = -(1LL << (T - 1));
+  int64_t const max_val = (1LL << (T - 1)) - 1;
+
+  for (int64_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i64div divider", static_cast<uint64_t>(divisor - min_val));
+    Divider<int64_t> const divider(divisor);
+    for (int64_t dividend = min_val; dividend <= max_val; ++dividend) {
+      int64_t const result = divider.divide(dividend);
+      int64_t const expected = i64div::normal_cal(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("i64div divider", dividend, "/", divisor, result, expected);
+      }
+      int64_t const rem_result = divider.remainder(dividend);
+      int64_t const rem_expected = i64div::normal_rem(dividend, divisor);
+      if (rem_result != rem_expected) {
+        report::mismatch("i64div divider", dividend, "%", divisor, rem_result, rem_expected);
+      }
+    }
+  }
+
+  int64_t const test_dividends[] = {
+      INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, 0, 1, -1, INT64_MAX / 2, INT64_MIN / 2,
+  };
+
+  int64_t const test_divisors[] = {
+      INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, INT64_MAX / 2 + 2, INT64_MIN / 2 - 1, 1, -1, 3, -3, 7, -7,
+  };
+
+  for (int64_t divisor : test_divisors) {
+    Divider<int64_t> const divider(divisor);
+    for (int64_t dividend : test_dividends) {
+      // Skip MIN / -1 as it's UB
+      if (dividend == INT64_MIN && divisor == -1)
+        continue;
+
+      int64_t const result = divider.divide(dividend);
+      int64_t const expected = i64div::normal_cal(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("i64div divider", dividend, "/", divisor, result, expected);
+      }
+      int64_t const rem_result = divider.remainder(dividend);
+      int64_t const rem_expected = i64div::normal_rem(dividend, divisor);
+      if (rem_result != rem_expected) {
+        report::mismatch("i64div divider", dividend, "%", divisor, rem_result, rem_expected);
+      }
+    }
+  }
+
+  report::finish("i64div divider");
+}
+
+void test_batch() {
+  std::mt19937_64 rng(2024);
+  std::vector<int64_t> input(1027);
+  std::vector<int64_t> output(input.size());
+
+  for (auto &value : input) {
+    value = static_cast<int64_t>(rng());
+  }
+  int64_t const test_dividends[] = {0, 1, -1, 2, -2, 100, -100, INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, INT64_MAX / 2, INT64_MIN / 2};
+  size_t k = 0;
+  for (int64_t dividend : test_dividends) {
+    input[k++] = dividend;
+  }
+
+  std::vector<int64_t> test_divisors = {1, -1, 2, -2, 3, -3, 7, -7, 1000, -1000, 1LL << 40, INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, INT64_MAX / 2 + 2, INT64_MIN / 2 - 1};
+  while (test_divisors.size() < 32) {
+    int64_t const divisor = static_cast<int64_t>(rng() >> (rng() % (sizeof(int64_t) * 8)));
+    if (divisor != 0) {
+      test_divisors.push_back(divisor);
+    }
+  }
+
+  std::vector<int64_t> remainders(input.size());
+  for (DispatchTier tier : {DispatchTier::Scalar, DispatchTier::BMI2, DispatchTier::SSE41, DispatchTier::AVX2, DispatchTier::AVX512, DispatchTier::NEON}) {
+    if (!force_dispatch_tier(tier)) {
+      continue;
+    }
+    for (int64_t divisor : test_divisors) {
+      Divider<int64_t> const divider(divisor);
+      divide(input.data(), output.data(), input.size(), divider);
+      remainder(input.data(), remainders.data(), input.size(), divider);
+      for (size_t i = 0; i < input.size(); ++i) {
+        // MIN / -1 wraps, like opt_cal_signed
+        int64_t const expected = input[i] == INT64_MIN && divisor == -1 ? INT64_MIN : i64div::normal_cal(input[i], divisor);
+        if (output[i] != expected) {
+          report::mismatch("i64div batch", input[i], report::tier_op("/", tier).c_str(), divisor, output[i], expected);
+        }
+        if (dispatch().i64.divide(input[i], divider) != expected) {
+          report::mismatch("i64div batch", input[i], report::tier_op("/ (scalar kernel)", tier).c_str(), divisor,
+                           dispatch().i64.divide(input[i], divider), expected);
+        }
+        int64_t const rem_expected = input[i] == INT64_MIN && divisor == -1 ? 0 : i64div::normal_rem(input[i], divisor);
+        if (remainders[i] != rem_expected) {
+          report::mismatch("i64div batch", input[i], report::tier_op("%", tier).c_str(), divisor, remainders[i], rem_expected);
+        }
+      }
+    }
+  }
+  reset_dispatch_tier();
+
+  report::finish("i64div batch");
+}
+
+template <int64_t D> void check_const_divider_at(int64_t dividend) {
+    // Skip MIN / -1 as it's UB
+    if (dividend == INT64_MIN && D == -1)
+      return;
+  int64_t const result = ConstDivider<int64_t, D>::divide(dividend);
+  int64_t const expected = i64div::normal_cal(dividend, D);
+  if (result != expected) {
+    std::cout << "Error: " << dividend << " / " << D << " = " << result << " instead " << expected << std::endl;
+    std::terminate();
+  }
+  int64_t const rem_result = ConstDivider<int64_t, D>::remainder(dividend);
+  int64_t const rem_expected = i64div::normal_rem(dividend, D);
+  if (rem_result != rem_expected) {
+    std::cout << "Error: " << dividend << " % " << D << " = " << rem_result << " instead " << rem_expected << std::endl;
+    std::terminate();
+  }
+  if (ConstDivider<int64_t, D>::is_divisible(dividend) != (rem_expected == 0)) {
+    std::cout << "Error: " << dividend << " divisible by " << D << " should be " << (rem_expected == 0) << std::endl;
+    std::terminate();
+  }  DivMod<int64_t> const qr = ConstDivider<int64_t, D>::divmod(dividend);
+  if (qr.quotient != expected || qr.remainder != rem_expected) {
+    std::cout << "Error: divmod(" << dividend << ", " << D << ") = {" << qr.quotient << ", " << qr.remainder << "}" << std::endl;
+    std::terminate();
+  }
+}
+
+template <int64_t D> void check_const_divider() {
+  for (int64_t dividend = -(static_cast<int64_t>(1) << (T - 1)); dividend <= (static_cast<int64_t>(1) << (T - 1)) - 1; ++dividend) {
+    check_const_divider_at<D>(dividend);
+  }
+  int64_t const test_dividends[] = {0, 1, -1, 100, -100, INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, INT64_MAX / 2, INT64_MIN / 2};
+  for (int64_t dividend : test_dividends) {
+    check_const_divider_at<D>(dividend);
+  }
+}
+
+void test_const_divider() {
+  check_const_divider<1>();
+  check_const_divider<-1>();
+  check_const_divider<2>();
+  check_const_divider<-2>();
+  check_const_divider<3>();
+  check_const_divider<-3>();
+  check_const_divider<7>();
+  check_const_divider<-7>();
+  check_const_divider<199>();
+  check_const_divider<-199>();
+  check_const_divider<1000>();
+  check_const_divider<86400>();
+  check_const_divider<-86400>();
+  check_const_divider<1LL << 40>();
+  check_const_divider<INT64_MAX>();
+  check_const_divider<INT64_MIN>();
+  check_const_divider<INT64_MIN + 1>();
+  check_const_divider<INT64_MAX / 2 + 2>();
+
+  std::cout << "i64div const divider tests passed!" << std::endl;
+}
+
+void test_fast_mod() {
+  int64_t const min_val = -(1LL << (T - 1));
+  int64_t const max_val = (1LL << (T - 1)) - 1;
+
+  for (int64_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i64div fastmod", static_cast<uint64_t>(divisor - min_val));
+    FastMod<int64_t> const fast_mod(divisor);
+    for (int64_t dividend = min_val; dividend <= max_val; ++dividend) {
+      int64_t const result = fast_mod.remainder(dividend);
+      int64_t const expected = i64div::normal_rem(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("i64div fastmod", dividend, "%", divisor, result, expected);
+      }
+    }
+  }
+
+  int64_t const test_dividends[] = {0, 1, -1, 100, -100, INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, INT64_MAX / 2, INT64_MIN / 2};
+  int64_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 7, -7, 1LL << 62, -(1LL << 62), INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1};
+
+  for (int64_t divisor : test_divisors) {
+    FastMod<int64_t> const fast_mod(divisor);
+    for (int64_t dividend : test_dividends) {
+      // MIN % -1 is UB for the built-in operator; fastmod gives 0
+      if (dividend == INT64_MIN && divisor == -1)
+        continue;
+      int64_t const result = fast_mod.remainder(dividend);
+      int64_t const expected = i64div::normal_rem(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("i64div fastmod", dividend, "%", divisor, result, expected);
+      }
+    }
+  }
+
+  report::finish("i64div fastmod");
+}
+void test_is_divisible() {
+  int64_t const min_val = -(1LL << (T - 1));
+  int64_t const max_val = (1LL << (T - 1)) - 1;
+
+  for (int64_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i64div divisibility", static_cast<uint64_t>(divisor - min_val));
+    DivisibilityTester<int64_t> const tester(divisor);
+    for (int64_t dividend = min_val; dividend <= max_val; ++dividend) {
+      // MIN % -1 is UB for the built-in operator, but every integer is divisible by -1
+      bool const expected = divisor == -1 || i64div::normal_rem(dividend, divisor) == 0;
+      if (tester.is_divisible(dividend) != expected || is_divisible(dividend, divisor) != expected) {
+        report::mismatch("i64div divisibility", dividend, "divisible by", divisor, !expected, expected);
+      }
+    }
+  }
+
+  int64_t const test_dividends[] = {0, 1, -1, 2, -2, 100, -100, 641, -641, INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, INT64_MAX / 3, INT64_MIN / 2};
+  int64_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 6, -6, 7, -7, 641, -641, 1LL << 62, -(1LL << 62), INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, INT64_MAX / 3};
+
+  for (int64_t divisor : test_divisors) {
+    DivisibilityTester<int64_t> const tester(divisor);
+    for (int64_t dividend : test_dividends) {
+      // MIN % -1 is UB for the built-in operator, but every integer is divisible by -1
+      bool const expected = divisor == -1 || i64div::normal_rem(dividend, divisor) == 0;
+      if (tester.is_divisible(dividend) != expected || is_divisible(dividend, divisor) != expected) {
+        report::mismatch("i64div divisibility", dividend, "divisible by", divisor, !expected, expected);
+      }
+    }
+  }
+
+  report::finish("i64div divisibility");
+}
+void test_divider_cache() {
+  int64_t const min_val = -(1LL << (T - 1));
+  int64_t const max_val = (1LL << (T - 1)) - 1;
+
+  // 64 slots for 4095 divisors: every divisor is inserted once and most of them are evicted again
+  DividerCache<int64_t> cache(64);
+  uint64_t lookups = 0;
+  for (int64_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i64div divider cache", static_cast<uint64_t>(divisor - min_val));
+    for (int64_t dividend = min_val; dividend <= max_val; ++dividend) {
+      int64_t const quotient = opt_cal_signed_cached(dividend, divisor, cache);
+      int64_t const remainder = opt_rem_signed_cached(dividend, divisor, cache);
+      lookups += 2;
+      if (quotient != normal_cal(dividend, divisor)) {
+        report::mismatch("i64div divider cache", dividend, "/", divisor, quotient, normal_cal(dividend, divisor));
+      }
+      if (remainder != normal_rem(dividend, divisor)) {
+        report::mismatch("i64div divider cache", dividend, "%", divisor, remainder, normal_rem(dividend, divisor));
+      }
+    }
+  }
+  DividerCacheStats stats = cache.stats();
+  if (stats.hits + stats.misses != lookups) {
+    report::mismatch("i64div divider cache", "hits + misses", "of", "sweep", stats.hits + stats.misses, lookups);
+  }
+  if (stats.misses < static_cast<uint64_t>((1ULL << T) - 1)) {
+    report::mismatch("i64div divider cache", "misses", "of", "sweep", stats.misses, "one per divisor or more");
+  }
+  if (stats.evictions == 0) {
+    report::mismatch("i64div divider cache", "evictions", "of", "sweep", stats.evictions, "some");
+  }
+
+  int64_t const test_dividends[] = {0, 1, -1, 100, -100, INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, INT64_MAX / 2, INT64_MIN / 2};
+  int64_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 7, -7, 1LL << 62, -(1LL << 62), INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1};
+
+  // Plenty of room: the second pass must hit for every divisor
+  DividerCache<int64_t> edge_cache(1024);
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int64_t divisor : test_divisors) {
+      for (int64_t dividend : test_dividends) {
+        int64_t const quotient = opt_cal_signed_cached(dividend, divisor, edge_cache);
+        int64_t const remainder = opt_rem_signed_cached(dividend, divisor, edge_cache);
+        if (quotient != opt_cal_signed(dividend, divisor)) {
+          report::mismatch("i64div divider cache", dividend, "/", divisor, quotient, opt_cal_signed(dividend, divisor));
+        }
+        if (remainder != opt_rem_signed(dividend, divisor)) {
+          report::mismatch("i64div divider cache", dividend, "%", divisor, remainder, opt_rem_signed(dividend, divisor));
+        }
+      }
+    }
+  }
+  stats = edge_cache.stats();
+  if (stats.misses != sizeof(test_divisors) / sizeof(test_divisors[0])) {
+    report::mismatch("i64div divider cache", "misses", "of", "edge cache", stats.misses, sizeof(test_divisors) / sizeof(test_divisors[0]));
+  }
+  if (stats.evictions != 0) {
+    report::mismatch("i64div divider cache", "evictions", "of", "edge cache", stats.evictions, 0);
+  }
+
+  report::finish("i64div divider cache");
+}
+
+void test_branchfree_divider() {
+  int64_t const min_val = -(1LL << (T - 1));
+  int64_t const max_val = (1LL << (T - 1)) - 1;
+
+  for (int64_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i64div branchfree divider", static_cast<uint64_t>(divisor - min_val));
+    BranchfreeDivider<int64_t> const divider(divisor);
+    for (int64_t dividend = min_val; dividend <= max_val; ++dividend) {
+      if (divider.divide(dividend) != normal_cal(dividend, divisor)) {
+        report::mismatch("i64div branchfree divider", dividend, "/", divisor, divider.divide(dividend), normal_cal(dividend, divisor));
+      }
+      if (divider.remainder(dividend) != normal_rem(dividend, divisor)) {
+        report::mismatch("i64div branchfree divider", dividend, "%", divisor, divider.remainder(dividend), normal_rem(dividend, divisor));
+      }
+    }
+  }
+
+  // Every case the branchy path special-cases: +-1, MIN, powers of two, large divisors, magic overflow
+  int64_t const test_dividends[] = {0, 1, -1, 100, -100, INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, INT64_MAX / 2, INT64_MIN / 2};
+  int64_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 7, -7, 1LL << 62, -(1LL << 62), (1LL << 62) + 1, -(1LL << 62) - 1, INT64_MAX, INT64_MAX - 1, INT64_MAX / 2 + 2,
+                               INT64_MIN / 2 - 1, INT64_MIN, INT64_MIN + 1};
+  for (int64_t divisor : test_divisors) {
+    BranchfreeDivider<int64_t> const divider(divisor);
+    for (int64_t dividend : test_dividends) {
+      // MIN / -1 wraps like opt_cal_signed
+      int64_t const expected = dividend == INT64_MIN && divisor == -1 ? INT64_MIN : normal_cal(dividend, divisor);
+      int64_t const expected_rem = dividend == INT64_MIN && divisor == -1 ? 0 : normal_rem(dividend, divisor);
+      if (divider.divide(dividend) != expected) {
+        report::mismatch("i64div branchfree divider", dividend, "/", divisor, divider.divide(dividend), expected);
+      }
+      if (divider.remainder(dividend) != expected_rem) {
+        report::mismatch("i64div branchfree divider", dividend, "%", divisor, divider.remainder(dividend), expected_rem);
+      }
+    }
+  }
+
+  report::finish("i64div branchfree divider");
+}
+
+void test_rounding() {
+  int64_t const min_val = -(1LL << (T - 1));
+  int64_t const max_val = (1LL << (T - 1)) - 1;
+
+  auto check = [](RoundingDivider<int64_t> const &divider, int64_t dividend) {
+    int64_t const divisor = divider.divisor();
+    int64_t const results[] = {
+        div_floor(dividend, divisor),  div_ceil(dividend, divisor),  div_euclid(dividend, divisor),  rem_floor(dividend, divisor),
+        rem_euclid(dividend, divisor), divider.div_floor(dividend), divider.div_ceil(dividend),     divider.div_euclid(dividend),
+        divider.rem_floor(dividend),   divider.rem_euclid(dividend),
+    };
+    int64_t const expected[] = {
+        reference_div_floor(dividend, divisor), reference_div_ceil(dividend, divisor),  reference_div_euclid(dividend, divisor),
+        reference_rem_floor(dividend, divisor), reference_rem_euclid(dividend, divisor),
+    };
+    char const *const names[] = {"div_floor", "div_ceil", "div_euclid", "rem_floor", "rem_euclid"};
+    char const *const divider_names[] = {"divider div_floor", "divider div_ceil", "divider div_euclid", "divider rem_floor", "divider rem_euclid"};
+    for (size_t i = 0; i < 10; ++i) {
+      if (results[i] != expected[i % 5]) {
+        report::mismatch("i64div rounding", dividend, i < 5 ? names[i % 5] : divider_names[i % 5], divisor, results[i], expected[i % 5]);
+      }
+    }
+  };
+
+  for (int64_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i64div rounding", static_cast<uint64_t>(divisor - min_val));
+    RoundingDivider<int64_t> const divider(divisor);
+    for (int64_t dividend = min_val; dividend <= max_val; ++dividend) {
+      check(divider, dividend);
+    }
+  }
+
+  int64_t const test_dividends[] = {0, 1, -1, 100, -100, INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, INT64_MAX / 2, INT64_MIN / 2};
+  int64_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 7, -7, (1LL << 62), -(1LL << 62), INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1};
+  for (int64_t divisor : test_divisors) {
+    RoundingDivider<int64_t> const divider(divisor);
+    for (int64_t dividend : test_dividends) {
+      // MIN / -1 is UB for the reference
+      if (dividend == INT64_MIN && divisor == -1)
+        continue;
+      check(divider, dividend);
+    }
+  }
+
+  report::finish("i64div rounding");
+}
+
+void test_divmod() {
+  int64_t const min_val = -(static_cast<int64_t>(1) << (T - 1));
+  int64_t const max_val = (static_cast<int64_t>(1) << (T - 1)) - 1;
+
+  for (int64_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    Divider<int64_t> const divider(divisor);
+    for (int64_t dividend = min_val; dividend <= max_val; ++dividend) {
+      // Skip MIN / -1 as it's UB
+      if (dividend == min_val && divisor == -1)
+        continue;
+      DivMod<int64_t> const qr = divmod(dividend, divisor);
+      DivMod<int64_t> const divider_qr = divmod(dividend, divider);
+      int64_t const expected = normal_cal(dividend, divisor);
+      int64_t const rem_expected = normal_rem(dividend, divisor);
+      if (qr.quotient != expected || divider_qr.quotient != expected) {
+        report::mismatch("i64div divmod", dividend, "/", divisor, qr.quotient != expected ? qr.quotient : divider_qr.quotient, expected);
+      }
+      if (qr.remainder != rem_expected || divider_qr.remainder != rem_expected) {
+        report::mismatch("i64div divmod", dividend, "%", divisor, qr.remainder != rem_expected ? qr.remainder : divider_qr.remainder, rem_expected);
+      }
+    }
+  }
+
+  // Batch form: both output arrays, on every tier, with lengths that leave a vector tail
+  std::mt19937_64 rng(2025);
+  std::vector<int64_t> input(1029);
+  for (auto &value : input) {
+    value = static_cast<int64_t>(rng());
+  }
+  int64_t const test_dividends[] = {0, 1, -1, 2, -2, 100, -100, INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, INT64_MAX / 2, INT64_MIN / 2};
+  size_t k = 0;
+  for (int64_t dividend : test_dividends) {
+    input[k++] = dividend;
+  }
+  int64_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 7, -7, 1000, -1000, 1LL << 40, INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, INT64_MAX / 2 + 2, INT64_MIN / 2 - 1};
+
+  std::vector<int64_t> quotients(input.size());
+  std::vector<int64_t> remainders(input.size());
+  for (DispatchTier tier : {DispatchTier::Scalar, DispatchTier::BMI2, DispatchTier::SSE41, DispatchTier::AVX2, DispatchTier::AVX512, DispatchTier::NEON}) {
+    if (!force_dispatch_tier(tier)) {
+      continue;
+    }
+    for (int64_t divisor : test_divisors) {
+      divmod(input.data(), quotients.data(), remainders.data(), input.size(), divisor);
+      for (size_t i = 0; i < input.size(); ++i) {
+        if (input[i] == INT64_MIN && divisor == -1)
+          continue;
+        if (quotients[i] != normal_cal(input[i], divisor)) {
+          report::mismatch("i64div divmod", input[i], report::tier_op("/", tier).c_str(), divisor, quotients[i], normal_cal(input[i], divisor));
+        }
+        if (remainders[i] != normal_rem(input[i], divisor)) {
+          report::mismatch("i64div divmod", input[i], report::tier_op("%", tier).c_str(), divisor, remainders[i], normal_rem(input[i], divisor));
+        }
+      }
+    }
+  }
+  reset_dispatch_tier();
+
+  report::finish("i64div divmod");
+}
+
+void test_format() {
+  char buffer[max_decimal_chars<int64_t>() + 1];
+  auto check = [&buffer](int64_t value) {
+    std::string const result(buffer, format_decimal(value, buffer));
+    if (result != std::to_string(value)) {
+      std::cout << "Error: format_decimal(" << value << ") = \"" << result << "\"" << std::endl;
+      std::terminate();
+    }
+  };
+
+  for (int64_t value = -(static_cast<int64_t>(1) << (T - 1)); value <= (static_cast<int64_t>(1) << (T - 1)) - 1; ++value) {
+    check(value);
+  }
+  // Both sides of every digit count change, and the extremes
+  for (int64_t power = 1; power <= INT64_MAX / 10; power *= 10) {
+    check(static_cast<int64_t>(power * 10));
+    check(static_cast<int64_t>(power * 10 - 1));
+    check(static_cast<int64_t>(power * 10 + 1));
+      check(static_cast<int64_t>(-power));
+      check(static_cast<int64_t>(-power + 1));
+      check(static_cast<int64_t>(-power - 1));
+  }
+  check(INT64_MAX);
+  check(INT64_MAX - 1);
+  check(INT64_MIN);
+  check(INT64_MIN + 1);
+
+  // Batch form: one buffer, separated values
+  std::mt19937_64 rng(2026);
+  std::vector<int64_t> input(1000);
+  for (auto &value : input) {
+    value = static_cast<int64_t>(rng() >> (rng() % (sizeof(int64_t) * 8)));
+  }
+  std::vector<char> text(input.size() * (max_decimal_chars<int64_t>() + 1));
+  char *const end = format_decimal(input.data(), input.size(), text.data(), ',');
+  std::string expected;
+  for (int64_t value : input) {
+    expected += std::to_string(value) + ',';
+  }
+  if (std::string(text.data(), end) != expected) {
+    std::cout << "Error: batch format_decimal differs from std::to_string" << std::endl;
+    std::terminate();
+  }
+
+  std::cout << "i64div format tests passed!" << std::endl;
+}
+
+void test_jit_divider() {
+  // Scalar and batch code for every divisor in range, against the built-in operator
+  std::vector<int64_t> dividends;
+  for (int64_t dividend = static_cast<int64_t>(-(1LL << (T - 1))); dividend <= static_cast<int64_t>((1LL << (T - 1)) - 1); ++dividend) {
+    dividends.push_back(dividend);
+  }
+  std::vector<int64_t> quotients(dividends.size());
+  bool compiled = true;
+  for (int64_t divisor = static_cast<int64_t>(-(1LL << (T - 1))); divisor <= static_cast<int64_t>((1LL << (T - 1)) - 1); ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("i64div jit divider", static_cast<uint64_t>(divisor - static_cast<int64_t>(-(1LL << (T - 1)))));
+    JitDivider<int64_t> const divider(divisor);
+    compiled = compiled && divider.compiled();
+    divider.divide(dividends.data(), quotients.data(), dividends.size());
+    for (size_t i = 0; i < dividends.size(); ++i) {
+      int64_t const expected = normal_cal(dividends[i], divisor);
+      if (divider.divide(dividends[i]) != expected) {
+        report::mismatch("i64div jit divider", dividends[i], "/", divisor, divider.divide(dividends[i]), expected);
+      }
+      if (quotients[i] != expected) {
+        report::mismatch("i64div jit divider", dividends[i], "batch /", divisor, quotients[i], expected);
+      }
+    }
+  }
+
+  // Every strategy at the edges of the range, and the fallback, against Divider<T>
+  std::vector<int64_t> test_dividends = {0, 1, -1, 100, -100, INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, INT64_MAX / 2, INT64_MIN / 2};
+  std::mt19937_64 rng(2029);
+  while (test_dividends.size() < 67) {
+    test_dividends.push_back(static_cast<int64_t>(rng()));
+  }
+  std::vector<int64_t> out(test_dividends.size());
+  int64_t const test_divisors[] = {1, -1, 2, -2, 3, -3, 7, -7, 1LL << 62, -(1LL << 62), (1LL << 62) + 1, -(1LL << 62) - 1, INT64_MAX, INT64_MAX - 1, INT64_MAX / 2 + 2, INT64_MIN / 2 - 1, INT64_MIN, INT64_MIN + 1};
+  for (int64_t divisor : test_divisors) {
+    Divider<int64_t> const reference(divisor);
+    for (bool allow_jit : {true, false}) {
+      JitDivider<int64_t> const divider(divisor, allow_jit);
+      if (!allow_jit && divider.compiled()) {
+        report::mismatch("i64div jit divider", "any", "/ (JIT disabled)", divisor, "compiled", "fallback");
+      }
+      divider.divide(test_dividends.data(), out.data(), test_dividends.size());
+      for (size_t i = 0; i < test_dividends.size(); ++i) {
+        int64_t const expected = reference.divide(test_dividends[i]);
+        if (divider.divide(test_dividends[i]) != expected || out[i] != expected) {
+          report::mismatch("i64div jit divider", test_dividends[i], allow_jit ? "/" : "fallback /", divisor, divider.divide(test_dividends[i]),
+                           expected);
+        }
+      }
+    }
+  }
+  if (!compiled) {
+    std::cout << "i64div jit divider: executable pages unavailable, checked the fallback only\n";
+  }
+
+  report::finish("i64div jit divider");
+}
+
+void test_stats() {
+  using stats::DivPath;
+  std::vector<StatsCase<int64_t>> const cases = {
+      {INT64_MIN, -1, DivPath::Overflow, false},
+      {100, 1, DivPath::One, false},
+      {100, -1, DivPath::MinusOne, false},
+      {-100, 8, DivPath::Pow2, false},
+      {-100, -8, DivPath::Pow2, false},
+      {100, (1LL << 62) + 1, DivPath::Large, false},
+      {100, 10, DivPath::MulShift, false},
+      {100, -10, DivPath::MulShift, true},
+      {100, 15, DivPath::MulAddShift, true},
+      {-100, 15, DivPath::MulAddShift, true}};
+  check_stats<int64_t>("i64div stats", [](int64_t dividend, int64_t divisor) { return opt_cal_signed(dividend, divisor); }, cases);
+}
+
+} // namespace i64div
@@ -0,0 +1,88 @@
+#include <string>
+
+#include "tests.h"
+
+int main(int argc, char **argv) {
+  // Output is buffered and flushed by report::summary()
+  std::ios::sync_with_stdio(false);
+
+  if (argc > 1 && std::string(argv[1]) == "verify") {
+    return verify::run_cli(argc - 2, argv + 2);
+  }
+
+  u32div::test_div();
+  u32div::test_rem();
+  u32div::test_large_divisor();
+  u32div::test_divider();
+  u32div::test_batch();
+  u32div::test_const_divider();
+  u32div::test_fast_mod();
+  u32div::test_is_divisible();
+  u32div::test_divider_cache();
+  u32div::test_fast_magic();
+  u32div::test_divmod();
+  u32div::test_format();
+  u32div::test_mixed_radix();
+  u32div::test_modular();
+  u32div::test_jit_divider();
+  u32div::test_float_divider();
+  u32div::test_stats();
+  u32div::test_progression();
+  i32div::test_div();
+  i32div::test_rem();
+  i32div::test_divider();
+  i32div::test_batch();
+  i32div::test_const_divider();
+  i32div::test_fast_mod();
+  i32div::test_is_divisible();
+  i32div::test_divider_cache();
+  i32div::test_branchfree_divider();
+  i32div::test_rounding();
+  i32div::test_divmod();
+  i32div::test_format();
+  i32div::test_jit_divider();
+  i32div::test_float_divider();
+  i32div::test_stats();
+  u64div::test_div();
+  u64div::test_rem();
+  u64div::test_overflow_cases();
+  u64div::test_divider();
+  u64div::test_batch();
+  u64div::test_const_divider();
+  u64div::test_fast_mod();
+  u64div::test_is_divisible();
+  u64div::test_divider_cache();
+  u64div::test_fast_magic();
+  u64div::test_divmod();
+  u64div::test_format();
+  u64div::test_mixed_radix();
+  u64div::test_modular();
+  u64div::test_jit_divider();
+  u64div::test_stats();
+  u64div::test_progression();
+  i64div::test_div();
+  i64div::test_rem();
+  i64div::test_overflow_cases();
+  i64div::test_divider();
+  i64div::test_batch();
+  i64div::test_const_divider();
+  i64div::test_fast_mod();
+  i64div::test_is_divisible();
+  i64div::test_divider_cache();
+  i64div::test_branchfree_divider();
+  i64div::test_rounding();
+  i64div::test_divmod();
+  i64div::test_format();
+  i64div::test_jit_divider();
+  i64div::test_stats();
+  u128div::test_div();
+  u128div::test_rem();
+  u128div::test_wide_divider();
+  u128div::test_limbs();
+  i128div::test_div();
+  i128div::test_rem();
+  i128div::test_wide_divider();
+  verify::test_sharded_verifier();
+  verify::test_magic_proofs();
+  return report::summary();
+}
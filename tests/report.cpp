@@ -0,0 +1,125 @@
+#include <chrono>
+#include <map>
+#include <mutex>
+
+#include "tests.h"
+
+namespace report {
+
+namespace {
+
+struct State {
+  std::mutex mutex;
+  std::map<std::string, uint64_t> counts;
+  std::vector<Mismatch> stored;
+  std::atomic<uint64_t> total{0};
+  std::atomic<int64_t> last_progress;
+  State();
+};
+
+State &state() {
+  static State instance;
+  return instance;
+}
+
+int64_t now_ms() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename UIntType> std::string unsigned_text(UIntType value) {
+  std::string digits;
+  do {
+    digits.insert(digits.begin(), static_cast<char>('0' + static_cast<int>(value % 10)));
+    value /= 10;
+  } while (value != 0);
+  return digits;
+}
+
+State::State() : last_progress(now_ms()) {
+}
+
+} // namespace
+
+void record(Mismatch mismatch) {
+  State &s = state();
+  s.total.fetch_add(1);
+  std::lock_guard<std::mutex> lock(s.mutex);
+  ++s.counts[mismatch.test];
+  if (s.stored.size() < kMaxStored) {
+    s.stored.push_back(std::move(mismatch));
+  }
+}
+
+uint64_t mismatches(std::string const &test) {
+  State &s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto const it = s.counts.find(test);
+  return it == s.counts.end() ? 0 : it->second;
+}
+
+uint64_t total_mismatches() {
+  return state().total.load();
+}
+
+void finish(std::string const &test) {
+  uint64_t const count = mismatches(test);
+  if (count == 0) {
+    std::cout << test << " tests passed!\n";
+  } else {
+    std::cout << test << " tests: " << count << " mismatches\n";
+  }
+}
+
+int summary() {
+  State &s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  if (s.counts.empty()) {
+    std::cout << std::flush;
+    return 0;
+  }
+  for (auto const &entry : s.counts) {
+    std::cout << "Error: " << entry.first << ": " << entry.second << " mismatches\n";
+    uint64_t shown = 0;
+    for (Mismatch const &m : s.stored) {
+      if (m.test != entry.first) {
+        continue;
+      }
+      ++shown;
+      std::cout << "  " << m.dividend << ' ' << m.op << ' ' << m.divisor << " = " << m.result << " instead " << m.expected;
+      if (m.has_magic) {
+        std::cout << " (magic 0x" << std::hex << m.magic << std::dec << ", shift " << m.shift << ", is_add " << m.is_add << ')';
+      }
+      std::cout << '\n';
+    }
+    if (shown < entry.second) {
+      std::cout << "  ... and " << entry.second - shown << " more\n";
+    }
+  }
+  std::cout << std::flush;
+  return 1;
+}
+
+void progress_line(char const *test, uint64_t done) {
+  State &s = state();
+  int64_t const now = now_ms();
+  int64_t last = s.last_progress.load();
+  if (now - last < 1000 || !s.last_progress.compare_exchange_strong(last, now)) {
+    return;
+  }
+  std::cout << "Processing " << test << ": " << done << '\n';
+}
+
+std::string tier_op(char const *op, DispatchTier tier) {
+  static char const *const names[] = {"scalar", "bmi2", "sse41", "avx2", "avx512", "neon"};
+  return std::string(op) + " (" + names[static_cast<size_t>(tier)] + ')';
+}
+
+std::string to_text(uint128 value) {
+  return unsigned_text(value);
+}
+
+std::string to_text(int128 value) {
+  return value < 0 ? "-" + unsigned_text(0 - static_cast<uint128>(value)) : unsigned_text(static_cast<uint128>(value));
+}
+
+} // namespace report
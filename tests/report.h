@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <divtomulti/divtomulti.h>
+
+// =============================================================================
+// Test reporting
+// =============================================================================
+
+// The sweeps record mismatches here and keep going instead of stopping at the
+// first one, so a broken divisor class shows up whole in one run. Output goes
+// through a buffered std::cout: progress at most once a second, failures once
+// at the end from summary().
+namespace report {
+
+// One failing check. Values are stored as text so every width, 128-bit
+// included, fits the same record. For 32- and 64-bit divisors the magic,
+// shift and is_add that Divider<T> picked are attached.
+struct Mismatch {
+  std::string test;
+  std::string dividend;
+  std::string op;
+  std::string divisor;
+  std::string result;
+  std::string expected;
+  bool has_magic = false;
+  uint64_t magic = 0; // bit pattern, zero-extended
+  unsigned shift = 0;
+  bool is_add = false;
+};
+
+// Thread-safe; only the failure path takes the lock. Details are kept for the
+// first kMaxStored mismatches, every later one is still counted.
+constexpr size_t kMaxStored = 4096;
+void record(Mismatch mismatch);
+
+uint64_t mismatches(std::string const &test);
+uint64_t total_mismatches();
+
+// Prints "<test> tests passed!", or the mismatch count recorded under test
+void finish(std::string const &test);
+
+// Prints every stored mismatch grouped by test and returns the exit code
+int summary();
+
+void progress_line(char const *test, uint64_t done);
+
+// Called once per outer sweep iteration; looks at the clock every 1024th
+inline void progress(char const *test, uint64_t done) {
+  if (done % 1024 == 0) {
+    progress_line(test, done);
+  }
+}
+
+std::string to_text(uint128 value);
+std::string to_text(int128 value);
+inline std::string to_text(bool value) {
+  return value ? "true" : "false";
+}
+inline std::string to_text(char const *value) {
+  return value;
+}
+inline std::string to_text(std::string const &value) {
+  return value;
+}
+template <typename IntType> std::string to_text(IntType value) {
+  return std::to_string(value);
+}
+
+// op text for a batch result, naming the dispatch tier it came from: "/ (avx2)"
+std::string tier_op(char const *op, DispatchTier tier);
+
+template <typename Dividend, typename Divisor, typename Result, typename Expected>
+void mismatch(char const *test, Dividend dividend, char const *op, Divisor divisor, Result result, Expected expected) {
+  Mismatch m;
+  m.test = test;
+  m.dividend = to_text(dividend);
+  m.op = op;
+  m.divisor = to_text(divisor);
+  m.result = to_text(result);
+  m.expected = to_text(expected);
+  if constexpr (std::is_integral<Divisor>::value && sizeof(Divisor) >= sizeof(uint32_t) && sizeof(Divisor) <= sizeof(uint64_t)) {
+    if (divisor != 0) {
+      Divider<Divisor> const divider(divisor);
+      m.has_magic = true;
+      m.magic = static_cast<uint64_t>(static_cast<typename std::make_unsigned<Divisor>::type>(divider.magic()));
+      m.shift = divider.shift();
+      m.is_add = divider.strategy() == DivStrategy::MulAddShift;
+    }
+  }
+  record(std::move(m));
+}
+
+// Per-thread counters, one cache line each: workers add to their own slot and
+// the reporting thread sums them, so counting never bounces a shared line
+class ProgressCounters {
+public:
+  explicit ProgressCounters(size_t threads) : slots_(threads) {
+  }
+
+  // Only thread `thread` writes its slot, so a relaxed load and store suffice
+  void add(size_t thread, uint64_t count) {
+    std::atomic<uint64_t> &value = slots_[thread].value;
+    value.store(value.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+  }
+
+  uint64_t total() const {
+    uint64_t sum = 0;
+    for (auto const &slot : slots_) {
+      sum += slot.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
+private:
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> value{0};
+    Slot() = default;
+    Slot(Slot const &other) : value(other.value.load()) {
+    }
+  };
+  std::vector<Slot> slots_;
+};
+
+} // namespace report
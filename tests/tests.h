@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <divtomulti/divtomulti.h>
+
+#include "report.h"
+
+constexpr size_t T = 12U;
+
+// Reference floor/ceil/Euclidean division: the truncating built-in operators,
+// fixed up by the sign of the remainder
+template <typename SIntType> SIntType reference_div_floor(SIntType dividend, SIntType divisor) {
+  SIntType const r = dividend % divisor;
+  return dividend / divisor - (r != 0 && (r < 0) != (divisor < 0) ? 1 : 0);
+}
+
+template <typename SIntType> SIntType reference_div_ceil(SIntType dividend, SIntType divisor) {
+  SIntType const r = dividend % divisor;
+  return dividend / divisor + (r != 0 && (r < 0) == (divisor < 0) ? 1 : 0);
+}
+
+template <typename SIntType> SIntType reference_div_euclid(SIntType dividend, SIntType divisor) {
+  SIntType const r = dividend % divisor;
+  return dividend / divisor - (r >= 0 ? 0 : divisor > 0 ? 1 : -1);
+}
+
+template <typename SIntType> SIntType reference_rem_floor(SIntType dividend, SIntType divisor) {
+  SIntType const r = dividend % divisor;
+  return r != 0 && (r < 0) != (divisor < 0) ? r + divisor : r;
+}
+
+template <typename SIntType> SIntType reference_rem_euclid(SIntType dividend, SIntType divisor) {
+  SIntType const r = dividend % divisor;
+  return r >= 0 ? r : divisor > 0 ? r + divisor : r - divisor;
+}
+
+template <typename UIntType> UIntType reference_mulmod(UIntType a, UIntType b, UIntType modulus) {
+  using WideType = typename WiderType<UIntType>::type;
+  return static_cast<UIntType>(static_cast<WideType>(a) * b % modulus);
+}
+
+template <typename UIntType> UIntType reference_powmod(UIntType base, uint64_t exponent, UIntType modulus) {
+  UIntType result = static_cast<UIntType>(1 % modulus);
+  for (; exponent != 0; exponent >>= 1) {
+    if ((exponent & 1) != 0) {
+      result = reference_mulmod(result, base, modulus);
+    }
+    base = reference_mulmod(base, base, modulus);
+  }
+  return result;
+}
+
+// One opt_cal call and the branch it should be counted under
+template <typename IntType> struct StatsCase {
+  IntType dividend;
+  IntType divisor;
+  stats::DivPath path;
+  bool negative_magic;
+};
+
+// Checks the stats.h counters: record() and the histogram directly, across a
+// joined thread, and the branches opt counts when DIVTOMULTI_STATS is on
+// (all zero when it is off)
+template <typename IntType, typename Opt> void check_stats(char const *test, Opt opt, std::vector<StatsCase<IntType>> const &cases) {
+  using stats::DivPath;
+  constexpr stats::Width width = stats::width_of<IntType>();
+  IntType const sampled = static_cast<IntType>(10);
+  IntType const other = std::numeric_limits<IntType>::max();
+
+  stats::reset();
+  for (uint64_t i = 0; i < 3 * stats::kSampleEvery; ++i) {
+    stats::record(DivPath::MulShift, sampled);
+  }
+  std::thread worker([other] {
+    for (uint64_t i = 0; i < stats::kSampleEvery; ++i) {
+      stats::record(DivPath::Large, other);
+    }
+  });
+  worker.join();
+  stats::Snapshot snap = stats::snapshot();
+  if (snap.count(width, DivPath::MulShift) != 3 * stats::kSampleEvery) {
+    report::mismatch(test, "record", "count", sampled, snap.count(width, DivPath::MulShift), 3 * stats::kSampleEvery);
+  }
+  if (snap.count(width, DivPath::Large) != stats::kSampleEvery) {
+    report::mismatch(test, "exited thread", "count", other, snap.count(width, DivPath::Large), stats::kSampleEvery);
+  }
+  auto const samples_of = [&](IntType divisor) {
+    auto const it = snap.divisors[static_cast<size_t>(width)].find(static_cast<int64_t>(divisor));
+    return it == snap.divisors[static_cast<size_t>(width)].end() ? uint64_t{0} : it->second;
+  };
+  if (samples_of(sampled) != 3 || samples_of(other) != 1 || snap.samples != 4 || snap.dropped != 0) {
+    report::mismatch(test, "histogram", "samples", sampled, samples_of(sampled), 3);
+  }
+  std::ostringstream csv;
+  stats::write_csv(csv, snap);
+  std::string const line = std::string(stats::width_name(width)) + ",path,mul_shift," + std::to_string(3 * stats::kSampleEvery) + "\n";
+  if (csv.str().find(line) == std::string::npos) {
+    report::mismatch(test, "write_csv", "line", sampled, csv.str().c_str(), line.c_str());
+  }
+
+  stats::reset();
+  uint64_t expected[stats::kPaths] = {};
+  for (StatsCase<IntType> const &c : cases) {
+    static_cast<void>(opt(c.dividend, c.divisor));
+    ++expected[static_cast<size_t>(c.path)];
+    expected[static_cast<size_t>(DivPath::NegativeMagic)] += c.negative_magic ? 1 : 0;
+  }
+  snap = stats::snapshot();
+  for (size_t p = 0; p < stats::kPaths; ++p) {
+    uint64_t const want = stats::enabled() ? expected[p] : 0;
+    if (snap.paths[static_cast<size_t>(width)][p] != want) {
+      report::mismatch(test, stats::path_name(static_cast<DivPath>(p)), "count", cases.size(), snap.paths[static_cast<size_t>(width)][p], want);
+    }
+  }
+  stats::reset();
+  report::finish(test);
+}
+
+namespace u32div {
+void test_div();
+void test_rem();
+void test_large_divisor();
+void test_divider();
+void test_batch();
+void test_const_divider();
+void test_fast_mod();
+void test_is_divisible();
+void test_divider_cache();
+void test_fast_magic();
+void test_divmod();
+void test_format();
+void test_mixed_radix();
+void test_modular();
+void test_jit_divider();
+void test_float_divider();
+void test_stats();
+void test_progression();
+} // namespace u32div
+
+namespace i32div {
+void test_div();
+void test_rem();
+void test_divider();
+void test_batch();
+void test_const_divider();
+void test_fast_mod();
+void test_is_divisible();
+void test_divider_cache();
+void test_branchfree_divider();
+void test_rounding();
+void test_divmod();
+void test_format();
+void test_jit_divider();
+void test_float_divider();
+void test_stats();
+} // namespace i32div
+
+namespace u64div {
+void test_div();
+void test_rem();
+void test_overflow_cases();
+void test_divider();
+void test_batch();
+void test_const_divider();
+void test_fast_mod();
+void test_is_divisible();
+void test_divider_cache();
+void test_fast_magic();
+void test_divmod();
+void test_format();
+void test_mixed_radix();
+void test_modular();
+void test_jit_divider();
+void test_stats();
+void test_progression();
+} // namespace u64div
+
+namespace i64div {
+void test_div();
+void test_rem();
+void test_overflow_cases();
+void test_divider();
+void test_batch();
+void test_const_divider();
+void test_fast_mod();
+void test_is_divisible();
+void test_divider_cache();
+void test_branchfree_divider();
+void test_rounding();
+void test_divmod();
+void test_format();
+void test_jit_divider();
+void test_stats();
+} // namespace i64div
+
+namespace u128div {
+void test_div();
+void test_rem();
+void test_wide_divider();
+void test_limbs();
+} // namespace u128div
+
+namespace i128div {
+void test_div();
+void test_rem();
+void test_wide_divider();
+} // namespace i128div
+
+namespace verify {
+int run_cli(int argc, char **argv);
+void test_sharded_verifier();
+void test_magic_proofs();
+} // namespace verify
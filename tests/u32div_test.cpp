@@ -0,0 +1,825 @@
+#include <atomic>
+#include <thread>
+
+#include "tests.h"
+
+namespace u32div {
+
+void test_div() {
+  for (uint32_t dividend = 0; dividend <= static_cast<uint32_t>((1ULL << T) - 1); ++dividend) {
+    report::progress("u32div div", static_cast<uint64_t>(dividend));
+    for (uint32_t divisor = 1; divisor <= static_cast<uint32_t>((1ULL << T) - 1); ++divisor) {
+      uint32_t const result = u32div::opt_cal(dividend, divisor);
+      uint32_t const expected = u32div::normal_cal(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("u32div div", dividend, "/", divisor, result, expected);
+      }
+    }
+  }
+
+  report::finish("u32div div");
+}
+
+void test_rem() {
+  for (uint32_t dividend = 0; dividend <= static_cast<uint32_t>((1ULL << T) - 1); ++dividend) {
+    report::progress("u32div rem", static_cast<uint64_t>(dividend));
+    for (uint32_t divisor = 1; divisor <= static_cast<uint32_t>((1ULL << T) - 1); ++divisor) {
+      uint32_t const result = u32div::opt_rem(dividend, divisor);
+      uint32_t const expected = u32div::normal_rem(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("u32div rem", dividend, "%", divisor, result, expected);
+      }
+    }
+  }
+
+  report::finish("u32div rem");
+}
+
+void test_large_divisor() {
+  uint32_t const max_32 = static_cast<uint32_t>(-1);
+  uint32_t const test_dividends[] = {0, 1, 100, max_32, max_32 - 1, max_32 / 2};
+  uint32_t const test_divisors[] = {max_32, max_32 - 1, max_32 / 2, (1U << 31), (1U << 31) + 1};
+
+  for (uint32_t dividend : test_dividends) {
+    for (uint32_t divisor : test_divisors) {
+      uint32_t const result = u32div::opt_cal(dividend, divisor);
+      uint32_t const expected = u32div::normal_cal(dividend, divisor);
+      if (result != expected) {
+        std::cout << "Error: " << dividend << " / " << divisor << " = " << result << " instead " << expected << std::endl;
+        std::terminate();
+      }
+    }
+  }
+
+  std::cout << "u32div large divisor tests passed!" << std::endl;
+}
+
+void test_divider() {
+  for (uint32_t divisor = 1; divisor <= static_cast<uint32_t>((1ULL << T) - 1); ++divisor) {
+    report::progress("u32div divider", static_cast<uint64_t>(divisor));
+    Divider<uint32_t> const divider(divisor);
+    for (uint32_t dividend = 0; dividend <= static_cast<uint32_t>((1ULL << T) - 1); ++dividend) {
+      uint32_t const result = divider.divide(dividend);
+      uint32_t const expected = u32div::normal_cal(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("u32div divider", dividend, "/", divisor, result, expected);
+      }
+      uint32_t const rem_result = divider.remainder(dividend);
+      uint32_t const rem_expected = u32div::normal_rem(dividend, divisor);
+      if (rem_result != rem_expected) {
+        report::mismatch("u32div divider", dividend, "%", divisor, rem_result, rem_expected);
+      }
+    }
+  }
+
+  uint32_t const max_32 = static_cast<uint32_t>(-1);
+  uint32_t const test_dividends[] = {0, 1, 100, max_32, max_32 - 1, max_32 / 2, (1U << 31), (1U << 31) + 1};
+  uint32_t const test_divisors[] = {1, 3, 7, 641, max_32, max_32 - 1, max_32 / 2, (1U << 31), (1U << 31) + 1, (1U << 30) + 1};
+
+  for (uint32_t divisor : test_divisors) {
+    Divider<uint32_t> const divider(divisor);
+    for (uint32_t dividend : test_dividends) {
+      uint32_t const result = divider.divide(dividend);
+      uint32_t const expected = u32div::normal_cal(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("u32div divider", dividend, "/", divisor, result, expected);
+      }
+    }
+  }
+
+  report::finish("u32div divider");
+}
+void test_batch() {
+  std::mt19937 rng(2024);
+  std::vector<uint32_t> input(1027);
+  std::vector<uint32_t> output(input.size());
+
+  for (auto &value : input) {
+    value = static_cast<uint32_t>(rng());
+  }
+  uint32_t const test_dividends[] = {0, 1, 2, 100, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, 1U << 31, (1U << 31) + 1};
+  size_t k = 0;
+  for (uint32_t dividend : test_dividends) {
+    input[k++] = dividend;
+  }
+
+  std::vector<uint32_t> test_divisors = {1, 2, 3, 7, 10, 641, 1000, 86400, 1U << 20, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, 1U << 31, (1U << 31) + 1};
+  while (test_divisors.size() < 32) {
+    uint32_t const divisor = static_cast<uint32_t>(rng() >> (rng() % (sizeof(uint32_t) * 8)));
+    if (divisor != 0) {
+      test_divisors.push_back(divisor);
+    }
+  }
+
+  std::vector<uint32_t> remainders(input.size());
+  for (DispatchTier tier : {DispatchTier::Scalar, DispatchTier::BMI2, DispatchTier::SSE41, DispatchTier::AVX2, DispatchTier::AVX512, DispatchTier::NEON}) {
+    if (!force_dispatch_tier(tier)) {
+      continue;
+    }
+    for (uint32_t divisor : test_divisors) {
+      Divider<uint32_t> const divider(divisor);
+      divide(input.data(), output.data(), input.size(), divider);
+      remainder(input.data(), remainders.data(), input.size(), divider);
+      for (size_t i = 0; i < input.size(); ++i) {
+        uint32_t const expected = u32div::normal_cal(input[i], divisor);
+        if (output[i] != expected) {
+          report::mismatch("u32div batch", input[i], report::tier_op("/", tier).c_str(), divisor, output[i], expected);
+        }
+        if (dispatch().u32.divide(input[i], divider) != expected) {
+          report::mismatch("u32div batch", input[i], report::tier_op("/ (scalar kernel)", tier).c_str(), divisor,
+                           dispatch().u32.divide(input[i], divider), expected);
+        }
+        uint32_t const rem_expected = u32div::normal_rem(input[i], divisor);
+        if (remainders[i] != rem_expected) {
+          report::mismatch("u32div batch", input[i], report::tier_op("%", tier).c_str(), divisor, remainders[i], rem_expected);
+        }
+      }
+    }
+  }
+  reset_dispatch_tier();
+
+  report::finish("u32div batch");
+}
+template <uint32_t D> void check_const_divider_at(uint32_t dividend) {
+  uint32_t const result = ConstDivider<uint32_t, D>::divide(dividend);
+  uint32_t const expected = u32div::normal_cal(dividend, D);
+  if (result != expected) {
+    std::cout << "Error: " << dividend << " / " << D << " = " << result << " instead " << expected << std::endl;
+    std::terminate();
+  }
+  uint32_t const rem_result = ConstDivider<uint32_t, D>::remainder(dividend);
+  uint32_t const rem_expected = u32div::normal_rem(dividend, D);
+  if (rem_result != rem_expected) {
+    std::cout << "Error: " << dividend << " % " << D << " = " << rem_result << " instead " << rem_expected << std::endl;
+    std::terminate();
+  }
+  if (ConstDivider<uint32_t, D>::is_divisible(dividend) != (rem_expected == 0)) {
+    std::cout << "Error: " << dividend << " divisible by " << D << " should be " << (rem_expected == 0) << std::endl;
+    std::terminate();
+  }  DivMod<uint32_t> const qr = ConstDivider<uint32_t, D>::divmod(dividend);
+  if (qr.quotient != expected || qr.remainder != rem_expected) {
+    std::cout << "Error: divmod(" << dividend << ", " << D << ") = {" << qr.quotient << ", " << qr.remainder << "}" << std::endl;
+    std::terminate();
+  }
+}
+
+template <uint32_t D> void check_const_divider() {
+  for (uint32_t dividend = 0; dividend <= static_cast<uint32_t>((1ULL << T) - 1); ++dividend) {
+    check_const_divider_at<D>(dividend);
+  }
+  uint32_t const test_dividends[] = {0, 1, 100, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, 1U << 31, (1U << 31) + 1};
+  for (uint32_t dividend : test_dividends) {
+    check_const_divider_at<D>(dividend);
+  }
+}
+
+void test_const_divider() {
+  check_const_divider<1>();
+  check_const_divider<2>();
+  check_const_divider<3>();
+  check_const_divider<7>();
+  check_const_divider<10>();
+  check_const_divider<199>();
+  check_const_divider<641>();
+  check_const_divider<1000>();
+  check_const_divider<86400>();
+  check_const_divider<4096>();
+  check_const_divider<UINT32_MAX>();
+  check_const_divider<UINT32_MAX / 2>();
+  check_const_divider<(1U << 31) + 1>();
+
+  std::cout << "u32div const divider tests passed!" << std::endl;
+}
+void test_fast_mod() {
+  for (uint32_t divisor = 1; divisor <= static_cast<uint32_t>((1ULL << T) - 1); ++divisor) {
+    report::progress("u32div fastmod", static_cast<uint64_t>(divisor));
+    FastMod<uint32_t> const fast_mod(divisor);
+    for (uint32_t dividend = 0; dividend <= static_cast<uint32_t>((1ULL << T) - 1); ++dividend) {
+      uint32_t const result = fast_mod.remainder(dividend);
+      uint32_t const expected = u32div::normal_rem(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("u32div fastmod", dividend, "%", divisor, result, expected);
+      }
+    }
+  }
+
+  uint32_t const test_dividends[] = {0, 1, 100, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, 1U << 31, (1U << 31) + 1};
+  uint32_t const test_divisors[] = {1, 2, 3, 7, 641, 1000, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, 1U << 31, (1U << 31) + 1};
+
+  for (uint32_t divisor : test_divisors) {
+    FastMod<uint32_t> const fast_mod(divisor);
+    for (uint32_t dividend : test_dividends) {
+      uint32_t const result = fast_mod.remainder(dividend);
+      uint32_t const expected = u32div::normal_rem(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("u32div fastmod", dividend, "%", divisor, result, expected);
+      }
+    }
+  }
+
+  report::finish("u32div fastmod");
+}
+void test_is_divisible() {
+  for (uint32_t divisor = 1; divisor <= static_cast<uint32_t>((1ULL << T) - 1); ++divisor) {
+    report::progress("u32div divisibility", static_cast<uint64_t>(divisor));
+    DivisibilityTester<uint32_t> const tester(divisor);
+    for (uint32_t dividend = 0; dividend <= static_cast<uint32_t>((1ULL << T) - 1); ++dividend) {
+      bool const expected = u32div::normal_rem(dividend, divisor) == 0;
+      if (tester.is_divisible(dividend) != expected || is_divisible(dividend, divisor) != expected) {
+        report::mismatch("u32div divisibility", dividend, "divisible by", divisor, !expected, expected);
+      }
+    }
+  }
+
+  uint32_t const test_dividends[] = {0, 1, 2, 100, 641, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, UINT32_MAX / 3, 1U << 31, (1U << 31) + 1, 4294967290U};
+  uint32_t const test_divisors[] = {1, 2, 3, 6, 7, 10, 641, 1000, 1U << 20, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, UINT32_MAX / 3, 1U << 31, (1U << 31) + 1};
+
+  for (uint32_t divisor : test_divisors) {
+    DivisibilityTester<uint32_t> const tester(divisor);
+    for (uint32_t dividend : test_dividends) {
+      bool const expected = u32div::normal_rem(dividend, divisor) == 0;
+      if (tester.is_divisible(dividend) != expected || is_divisible(dividend, divisor) != expected) {
+        report::mismatch("u32div divisibility", dividend, "divisible by", divisor, !expected, expected);
+      }
+    }
+  }
+
+  report::finish("u32div divisibility");
+}
+void test_divider_cache() {
+  // 64 slots for 4095 divisors: every divisor is inserted once and most of them are evicted again
+  DividerCache<uint32_t> cache(64);
+  uint64_t lookups = 0;
+  for (uint32_t divisor = 1; divisor <= static_cast<uint32_t>((1ULL << T) - 1); ++divisor) {
+    report::progress("u32div divider cache", static_cast<uint64_t>(divisor));
+    for (uint32_t dividend = 0; dividend <= static_cast<uint32_t>((1ULL << T) - 1); ++dividend) {
+      uint32_t const quotient = opt_cal_cached(dividend, divisor, cache);
+      uint32_t const remainder = opt_rem_cached(dividend, divisor, cache);
+      lookups += 2;
+      if (quotient != normal_cal(dividend, divisor)) {
+        report::mismatch("u32div divider cache", dividend, "/", divisor, quotient, normal_cal(dividend, divisor));
+      }
+      if (remainder != normal_rem(dividend, divisor)) {
+        report::mismatch("u32div divider cache", dividend, "%", divisor, remainder, normal_rem(dividend, divisor));
+      }
+    }
+  }
+  DividerCacheStats stats = cache.stats();
+  if (stats.hits + stats.misses != lookups) {
+    report::mismatch("u32div divider cache", "hits + misses", "of", "sweep", stats.hits + stats.misses, lookups);
+  }
+  if (stats.misses < static_cast<uint64_t>((1ULL << T) - 1)) {
+    report::mismatch("u32div divider cache", "misses", "of", "sweep", stats.misses, "one per divisor or more");
+  }
+  if (stats.evictions == 0) {
+    report::mismatch("u32div divider cache", "evictions", "of", "sweep", stats.evictions, "some");
+  }
+
+  uint32_t const test_dividends[] = {0, 1, 100, 641, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, UINT32_MAX / 3, 1U << 31, (1U << 31) + 1};
+  uint32_t const test_divisors[] = {1, 2, 3, 7, 641, 1000, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, 1U << 31, (1U << 31) + 1};
+
+  // Plenty of room: the second pass must hit for every divisor
+  DividerCache<uint32_t> edge_cache(1024);
+  for (int pass = 0; pass < 2; ++pass) {
+    for (uint32_t divisor : test_divisors) {
+      for (uint32_t dividend : test_dividends) {
+        uint32_t const quotient = opt_cal_cached(dividend, divisor, edge_cache);
+        uint32_t const remainder = opt_rem_cached(dividend, divisor, edge_cache);
+        if (quotient != normal_cal(dividend, divisor)) {
+          report::mismatch("u32div divider cache", dividend, "/", divisor, quotient, normal_cal(dividend, divisor));
+        }
+        if (remainder != normal_rem(dividend, divisor)) {
+          report::mismatch("u32div divider cache", dividend, "%", divisor, remainder, normal_rem(dividend, divisor));
+        }
+      }
+    }
+  }
+  stats = edge_cache.stats();
+  if (stats.misses != sizeof(test_divisors) / sizeof(test_divisors[0])) {
+    report::mismatch("u32div divider cache", "misses", "of", "edge cache", stats.misses, sizeof(test_divisors) / sizeof(test_divisors[0]));
+  }
+  if (stats.evictions != 0) {
+    report::mismatch("u32div divider cache", "evictions", "of", "edge cache", stats.evictions, 0);
+  }
+
+  // Threads sharing a cache far smaller than their divisor set, so inserts and evictions race with lookups
+  DividerCache<uint32_t> shared_cache(16);
+  std::atomic<bool> failed(false);
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&shared_cache, &failed, t] {
+      std::mt19937 rng(t);
+      for (int i = 0; i < 200000 && !failed.load(std::memory_order_relaxed); ++i) {
+        uint32_t const divisor = 1 + rng() % 256;
+        uint32_t const dividend = static_cast<uint32_t>(rng());
+        uint32_t const quotient = opt_cal_cached(dividend, divisor, shared_cache);
+        if (quotient != dividend / divisor) {
+          report::mismatch("u32div divider cache", dividend, "/ (concurrent)", divisor, quotient, dividend / divisor);
+          failed.store(true);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  report::finish("u32div divider cache");
+}
+void test_fast_magic() {
+  auto check = [](uint32_t divisor) {
+    auto const slow = get_unsigned_magic(divisor);
+    auto const fast = get_unsigned_magic_fast(divisor);
+    if (slow.magic != fast.magic || slow.shift != fast.shift || slow.is_add != fast.is_add) {
+      report::mismatch("u32div fast magic", "any", "magic", divisor, fast.magic, slow.magic);
+    }
+  };
+  for (uint32_t divisor = 2; divisor <= static_cast<uint32_t>((1ULL << T) - 1); ++divisor) {
+    check(divisor);
+  }
+  uint32_t const test_divisors[] = {3, 7, 641, 1000, 6700417, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, UINT32_MAX / 3, (1U << 31) - 1, (1U << 31) + 1};
+  for (uint32_t divisor : test_divisors) {
+    check(divisor);
+  }
+  // Both ends of every power-of-two interval, where ceil(log2 d) changes
+  for (unsigned bit = 1; bit < sizeof(uint32_t) * 8; ++bit) {
+    uint32_t const pow2 = static_cast<uint32_t>(uint32_t(1) << bit);
+    check(pow2);
+    check(static_cast<uint32_t>(pow2 + 1));
+    if (bit > 1) {
+      check(static_cast<uint32_t>(pow2 - 1));
+    }
+  }
+
+  report::finish("u32div fast magic");
+}
+void test_divmod() {
+  uint32_t const min_val = 0;
+  uint32_t const max_val = static_cast<uint32_t>((static_cast<uint32_t>(1) << T) - 1);
+
+  for (uint32_t divisor = min_val; divisor <= max_val; ++divisor) {
+    if (divisor == 0)
+      continue;
+    Divider<uint32_t> const divider(divisor);
+    for (uint32_t dividend = min_val; dividend <= max_val; ++dividend) {
+      DivMod<uint32_t> const qr = divmod(dividend, divisor);
+      DivMod<uint32_t> const divider_qr = divmod(dividend, divider);
+      uint32_t const expected = normal_cal(dividend, divisor);
+      uint32_t const rem_expected = normal_rem(dividend, divisor);
+      if (qr.quotient != expected || divider_qr.quotient != expected) {
+        report::mismatch("u32div divmod", dividend, "/", divisor, qr.quotient != expected ? qr.quotient : divider_qr.quotient, expected);
+      }
+      if (qr.remainder != rem_expected || divider_qr.remainder != rem_expected) {
+        report::mismatch("u32div divmod", dividend, "%", divisor, qr.remainder != rem_expected ? qr.remainder : divider_qr.remainder, rem_expected);
+      }
+    }
+  }
+
+  // Batch form: both output arrays, on every tier, with lengths that leave a vector tail
+  std::mt19937 rng(2025);
+  std::vector<uint32_t> input(1029);
+  for (auto &value : input) {
+    value = static_cast<uint32_t>(rng());
+  }
+  uint32_t const test_dividends[] = {0, 1, 2, 100, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, 1U << 31, (1U << 31) + 1};
+  size_t k = 0;
+  for (uint32_t dividend : test_dividends) {
+    input[k++] = dividend;
+  }
+  uint32_t const test_divisors[] = {1, 2, 3, 7, 10, 641, 1000, 86400, 1U << 20, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, 1U << 31, (1U << 31) + 1};
+
+  std::vector<uint32_t> quotients(input.size());
+  std::vector<uint32_t> remainders(input.size());
+  for (DispatchTier tier : {DispatchTier::Scalar, DispatchTier::BMI2, DispatchTier::SSE41, DispatchTier::AVX2, DispatchTier::AVX512, DispatchTier::NEON}) {
+    if (!force_dispatch_tier(tier)) {
+      continue;
+    }
+    for (uint32_t divisor : test_divisors) {
+      divmod(input.data(), quotients.data(), remainders.data(), input.size(), divisor);
+      for (size_t i = 0; i < input.size(); ++i) {
+        if (quotients[i] != normal_cal(input[i], divisor)) {
+          report::mismatch("u32div divmod", input[i], report::tier_op("/", tier).c_str(), divisor, quotients[i], normal_cal(input[i], divisor));
+        }
+        if (remainders[i] != normal_rem(input[i], divisor)) {
+          report::mismatch("u32div divmod", input[i], report::tier_op("%", tier).c_str(), divisor, remainders[i], normal_rem(input[i], divisor));
+        }
+      }
+    }
+  }
+  reset_dispatch_tier();
+
+  report::finish("u32div divmod");
+}
+void test_format() {
+  char buffer[max_decimal_chars<uint32_t>() + 1];
+  auto check = [&buffer](uint32_t value) {
+    std::string const result(buffer, format_decimal(value, buffer));
+    if (result != std::to_string(value)) {
+      std::cout << "Error: format_decimal(" << value << ") = \"" << result << "\"" << std::endl;
+      std::terminate();
+    }
+  };
+
+  for (uint32_t value = 0; value <= static_cast<uint32_t>((static_cast<uint32_t>(1) << T) - 1); ++value) {
+    check(value);
+  }
+  // Both sides of every digit count change, and the extremes
+  for (uint32_t power = 1; power <= UINT32_MAX / 10; power *= 10) {
+    check(static_cast<uint32_t>(power * 10));
+    check(static_cast<uint32_t>(power * 10 - 1));
+    check(static_cast<uint32_t>(power * 10 + 1));
+  }
+  check(UINT32_MAX);
+  check(UINT32_MAX - 1);
+  check(0);
+  check(0 + 1);
+
+  // Batch form: one buffer, separated values
+  std::mt19937 rng(2026);
+  std::vector<uint32_t> input(1000);
+  for (auto &value : input) {
+    value = static_cast<uint32_t>(rng() >> (rng() % (sizeof(uint32_t) * 8)));
+  }
+  std::vector<char> text(input.size() * (max_decimal_chars<uint32_t>() + 1));
+  char *const end = format_decimal(input.data(), input.size(), text.data(), ',');
+  std::string expected;
+  for (uint32_t value : input) {
+    expected += std::to_string(value) + ',';
+  }
+  if (std::string(text.data(), end) != expected) {
+    std::cout << "Error: batch format_decimal differs from std::to_string" << std::endl;
+    std::terminate();
+  }
+
+  std::cout << "u32div format tests passed!" << std::endl;
+}
+void test_mixed_radix() {
+  std::vector<std::vector<uint32_t>> const shapes = {{3, 5, 7}, {60, 60, 24}, {1, 2, 1, 641}, {10, 10, 10, 10, 10, 10, 10, 10, 10}, {65536, 65536}, {UINT32_MAX}, {(1U << 31) + 1, 2}};
+  std::mt19937 rng(2027);
+  std::vector<uint32_t> input(1029);
+  for (auto &value : input) {
+    value = static_cast<uint32_t>(rng() >> (rng() % (sizeof(uint32_t) * 8)));
+  }
+  uint32_t const test_values[] = {0, 1, 59, 60, 86399, 86400, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2};
+  size_t k = 0;
+  for (uint32_t value : test_values) {
+    input[k++] = value;
+  }
+
+  for (auto const &shape : shapes) {
+    MixedRadix<uint32_t> const radix(shape.data(), shape.size());
+    // Reference: the same chain with the built-in operators
+    auto expect = [&shape](uint32_t value, std::vector<uint32_t> &digits) {
+      for (size_t s = 0; s < shape.size(); ++s) {
+        digits[s] = value % shape[s];
+        value /= shape[s];
+      }
+      return value;
+    };
+    std::vector<uint32_t> digits(shape.size());
+    std::vector<uint32_t> expected(shape.size());
+    auto check = [&](uint32_t value) {
+      uint32_t const high = radix.decompose(value, digits.data());
+      if (high != expect(value, expected) || digits != expected) {
+        report::mismatch("u32div mixed radix", value, "decompose", shape[0], high, expect(value, expected));
+      }
+    };
+    for (uint32_t value = 0; value < static_cast<uint32_t>(1ULL << T); ++value) {
+      check(value);
+    }
+    for (uint32_t value : input) {
+      check(value);
+    }
+
+    std::vector<std::vector<uint32_t>> batch_digits(shape.size(), std::vector<uint32_t>(input.size()));
+    std::vector<uint32_t *> digit_arrays;
+    for (auto &array : batch_digits) {
+      digit_arrays.push_back(array.data());
+    }
+    std::vector<uint32_t> high(input.size());
+    for (DispatchTier tier : {DispatchTier::Scalar, DispatchTier::BMI2, DispatchTier::SSE41, DispatchTier::AVX2, DispatchTier::AVX512, DispatchTier::NEON}) {
+      if (!force_dispatch_tier(tier)) {
+        continue;
+      }
+      radix.decompose(input.data(), input.size(), digit_arrays.data(), high.data());
+      for (size_t i = 0; i < input.size(); ++i) {
+        bool same = high[i] == expect(input[i], expected);
+        for (size_t s = 0; s < shape.size(); ++s) {
+          same = same && batch_digits[s][i] == expected[s];
+        }
+        if (!same) {
+          report::mismatch("u32div mixed radix", input[i], report::tier_op("decompose", tier).c_str(), shape[0], high[i], expect(input[i], expected));
+        }
+      }
+    }
+    reset_dispatch_tier();
+  }
+
+  report::finish("u32div mixed radix");
+}
+
+void test_modular() {
+  // Exhaustive: every modulus below 2^(T-4) with every pair of residues
+  for (uint32_t modulus = 1; modulus < static_cast<uint32_t>(1U << (T - 4)); ++modulus) {
+    Barrett<uint32_t> const barrett(modulus);
+    for (uint32_t a = 0; a < modulus; ++a) {
+      for (uint32_t b = 0; b < modulus; ++b) {
+        uint32_t const expected = reference_mulmod(a, b, modulus);
+        if (barrett.mulmod(a, b) != expected) {
+          report::mismatch("u32div modular", static_cast<uint64_t>(a) * b, "% (Barrett)", modulus, barrett.mulmod(a, b), expected);
+        }
+        if ((modulus & 1) != 0 && Montgomery<uint32_t>(modulus).mulmod(a, b) != expected) {
+          report::mismatch("u32div modular", static_cast<uint64_t>(a) * b, "% (Montgomery)", modulus, Montgomery<uint32_t>(modulus).mulmod(a, b),
+                           expected);
+        }
+      }
+    }
+  }
+
+  // Full residue range of the small moduli against one operand, and the
+  // powers of every residue up to 2^T
+  for (uint32_t modulus = 1; modulus < static_cast<uint32_t>(1U << T); modulus += 37) {
+    Barrett<uint32_t> const barrett(modulus);
+    Montgomery<uint32_t> const montgomery(modulus | 1);
+    for (uint32_t a = 0; a < modulus; ++a) {
+      uint32_t const b = modulus - 1 - a / 2;
+      if (barrett.mulmod(a, b) != reference_mulmod(a, b, modulus)) {
+        report::mismatch("u32div modular", static_cast<uint64_t>(a) * b, "% (Barrett)", modulus, barrett.mulmod(a, b),
+                         reference_mulmod(a, b, modulus));
+      }
+      if (montgomery.mulmod(a, b) != reference_mulmod<uint32_t>(a, b, modulus | 1)) {
+        report::mismatch("u32div modular", static_cast<uint64_t>(a) * b, "% (Montgomery)", modulus | 1, montgomery.mulmod(a, b),
+                         reference_mulmod<uint32_t>(a, b, modulus | 1));
+      }
+      uint64_t const exponent = a * 7919ULL;
+      if (barrett.powmod(a, exponent) != reference_powmod(a, exponent, modulus)) {
+        report::mismatch("u32div modular", a, "powmod (Barrett)", modulus, barrett.powmod(a, exponent), reference_powmod(a, exponent, modulus));
+      }
+      if (montgomery.powmod(a, exponent) != reference_powmod<uint32_t>(a, exponent, modulus | 1)) {
+        report::mismatch("u32div modular", a, "powmod (Montgomery)", modulus | 1, montgomery.powmod(a, exponent),
+                         reference_powmod<uint32_t>(a, exponent, modulus | 1));
+      }
+    }
+  }
+
+  // Moduli at the top of the range, where the Barrett estimate and the
+  // Montgomery subtraction are closest to wrapping
+  uint32_t const moduli[] = {UINT32_MAX, UINT32_MAX - 1, UINT32_MAX - 2, UINT32_MAX / 2, UINT32_MAX / 2 + 1, UINT32_MAX / 2 + 2, 4294967291U, 3, 2, 1};
+  std::mt19937_64 rng(2028);
+  size_t const n = 1027;
+  std::vector<uint32_t> a(n);
+  std::vector<uint32_t> b(n);
+  std::vector<uint32_t> out(n);
+  for (uint32_t modulus : moduli) {
+    for (size_t i = 0; i < n; ++i) {
+      a[i] = static_cast<uint32_t>(rng() % modulus);
+      b[i] = static_cast<uint32_t>(rng() % modulus);
+    }
+    a[0] = modulus - 1;
+    b[0] = modulus - 1;
+    a[1] = modulus - 1;
+    b[1] = modulus / 2;
+
+    Barrett<uint32_t> const barrett(modulus);
+    barrett.mulmod(a.data(), b.data(), out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      uint32_t const expected = reference_mulmod(a[i], b[i], modulus);
+      if (out[i] != expected || barrett.mulmod(a[i], b[i]) != expected) {
+        report::mismatch("u32div modular", static_cast<uint64_t>(a[i]) * b[i], "% (Barrett)", modulus,
+                         out[i] != expected ? out[i] : barrett.mulmod(a[i], b[i]), expected);
+      }
+      uint64_t const exponent = rng();
+      if (barrett.powmod(a[i], exponent) != reference_powmod(a[i], exponent, modulus)) {
+        report::mismatch("u32div modular", a[i], "powmod (Barrett)", modulus, barrett.powmod(a[i], exponent),
+                         reference_powmod(a[i], exponent, modulus));
+      }
+    }
+
+    if ((modulus & 1) == 0) {
+      continue;
+    }
+    Montgomery<uint32_t> const montgomery(modulus);
+    montgomery.mulmod(a.data(), b.data(), out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      if (out[i] != reference_mulmod(a[i], b[i], modulus)) {
+        report::mismatch("u32div modular", static_cast<uint64_t>(a[i]) * b[i], "% (Montgomery)", modulus, out[i],
+                         reference_mulmod(a[i], b[i], modulus));
+      }
+      if (montgomery.from_montgomery(montgomery.to_montgomery(a[i])) != a[i]) {
+        report::mismatch("u32div modular", a[i], "Montgomery round trip", modulus, montgomery.from_montgomery(montgomery.to_montgomery(a[i])), a[i]);
+      }
+      uint64_t const exponent = rng();
+      if (montgomery.powmod(a[i], exponent) != reference_powmod(a[i], exponent, modulus)) {
+        report::mismatch("u32div modular", a[i], "powmod (Montgomery)", modulus, montgomery.powmod(a[i], exponent),
+                         reference_powmod(a[i], exponent, modulus));
+      }
+    }
+  }
+
+  // Moduli above 2^31, with both operands among the top residues: the
+  // uncorrected Barrett remainder can reach 2m - 1 >= 2^32 there
+  uint32_t const wide_moduli[] = {0x80000001U, 0x80000003U, 0xA5A5A5A5U, 0xC0000001U, 0xFFFFFFF1U, 4294967291U, UINT32_MAX - 1, UINT32_MAX};
+  uint32_t const window = 512;
+  for (uint32_t modulus : wide_moduli) {
+    Barrett<uint32_t> const barrett(modulus);
+    for (uint32_t i = 1; i <= window; ++i) {
+      uint32_t const a_top = modulus - i;
+      for (uint32_t j = 1; j <= window; ++j) {
+        uint32_t const b_top = modulus - j;
+        uint32_t const expected = reference_mulmod(a_top, b_top, modulus);
+        uint32_t const result = barrett.mulmod(a_top, b_top);
+        if (result != expected) {
+          report::mismatch("u32div modular", static_cast<uint64_t>(a_top) * b_top, "%", modulus, result, expected);
+        }
+      }
+    }
+  }
+  report::finish("u32div modular");
+}
+
+void test_jit_divider() {
+  // Scalar and batch code for every divisor in range, against the built-in operator
+  std::vector<uint32_t> dividends;
+  for (uint32_t dividend = static_cast<uint32_t>(0); dividend <= static_cast<uint32_t>((1ULL << T) - 1); ++dividend) {
+    dividends.push_back(dividend);
+  }
+  std::vector<uint32_t> quotients(dividends.size());
+  bool compiled = true;
+  for (uint32_t divisor = static_cast<uint32_t>(0); divisor <= static_cast<uint32_t>((1ULL << T) - 1); ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("u32div jit divider", static_cast<uint64_t>(divisor - static_cast<uint32_t>(0)));
+    JitDivider<uint32_t> const divider(divisor);
+    compiled = compiled && divider.compiled();
+    divider.divide(dividends.data(), quotients.data(), dividends.size());
+    for (size_t i = 0; i < dividends.size(); ++i) {
+      uint32_t const expected = normal_cal(dividends[i], divisor);
+      if (divider.divide(dividends[i]) != expected) {
+        report::mismatch("u32div jit divider", dividends[i], "/", divisor, divider.divide(dividends[i]), expected);
+      }
+      if (quotients[i] != expected) {
+        report::mismatch("u32div jit divider", dividends[i], "batch /", divisor, quotients[i], expected);
+      }
+    }
+  }
+
+  // Every strategy at the edges of the range, and the fallback, against Divider<T>
+  std::vector<uint32_t> test_dividends = {0, 1, 2, 100, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, 1U << 31, (1U << 31) + 1};
+  std::mt19937_64 rng(2029);
+  while (test_dividends.size() < 67) {
+    test_dividends.push_back(static_cast<uint32_t>(rng()));
+  }
+  std::vector<uint32_t> out(test_dividends.size());
+  uint32_t const test_divisors[] = {1, 2, 3, 7, 10, 641, 1U << 20, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, 1U << 31, (1U << 31) + 1};
+  for (uint32_t divisor : test_divisors) {
+    Divider<uint32_t> const reference(divisor);
+    for (bool allow_jit : {true, false}) {
+      JitDivider<uint32_t> const divider(divisor, allow_jit);
+      if (!allow_jit && divider.compiled()) {
+        report::mismatch("u32div jit divider", "any", "/ (JIT disabled)", divisor, "compiled", "fallback");
+      }
+      divider.divide(test_dividends.data(), out.data(), test_dividends.size());
+      for (size_t i = 0; i < test_dividends.size(); ++i) {
+        uint32_t const expected = reference.divide(test_dividends[i]);
+        if (divider.divide(test_dividends[i]) != expected || out[i] != expected) {
+          report::mismatch("u32div jit divider", test_dividends[i], allow_jit ? "/" : "fallback /", divisor, divider.divide(test_dividends[i]),
+                           expected);
+        }
+      }
+    }
+  }
+  if (!compiled) {
+    std::cout << "u32div jit divider: executable pages unavailable, checked the fallback only\n";
+  }
+
+  report::finish("u32div jit divider");
+}
+
+void test_float_divider() {
+  std::vector<uint32_t> dividends;
+  for (uint32_t dividend = static_cast<uint32_t>(0); dividend <= static_cast<uint32_t>((1ULL << T) - 1); ++dividend) {
+    dividends.push_back(dividend);
+  }
+  std::vector<uint32_t> quotients(dividends.size());
+  std::vector<uint32_t> remainders(dividends.size());
+  for (uint32_t divisor = static_cast<uint32_t>(0); divisor <= static_cast<uint32_t>((1ULL << T) - 1); ++divisor) {
+    if (divisor == 0)
+      continue;
+    report::progress("u32div float divider", static_cast<uint64_t>(divisor - static_cast<uint32_t>(0)));
+    FloatDivider<uint32_t> const divider(divisor);
+    divide(dividends.data(), quotients.data(), dividends.size(), divider);
+    remainder(dividends.data(), remainders.data(), dividends.size(), divider);
+    for (size_t i = 0; i < dividends.size(); ++i) {
+      uint32_t const dividend = dividends[i];
+      uint32_t const expected = normal_cal(dividend, divisor);
+      uint32_t const expected_rem = normal_rem(dividend, divisor);
+      if (divider.divide(dividend) != expected || quotients[i] != expected) {
+        report::mismatch("u32div float divider", dividend, "/", divisor, quotients[i], expected);
+      }
+      if (divider.remainder(dividend) != expected_rem || remainders[i] != expected_rem) {
+        report::mismatch("u32div float divider", dividend, "%", divisor, remainders[i], expected_rem);
+      }
+    }
+  }
+
+  // Edge divisors and dividends through every tier's batch path, against Divider<T>
+  std::vector<uint32_t> test_dividends = {0, 1, 2, 100, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, 1U << 31, (1U << 31) + 1, 4294967290U};
+  std::mt19937 rng(2030);
+  while (test_dividends.size() < 1027) {
+    test_dividends.push_back(static_cast<uint32_t>(rng()));
+  }
+  uint32_t const test_divisors[] = {1, 2, 3, 7, 10, 641, 1U << 20, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 2, UINT32_MAX / 3, 1U << 31, (1U << 31) + 1, 65537};
+  std::vector<uint32_t> out(test_dividends.size());
+  std::vector<uint32_t> out_rem(test_dividends.size());
+  for (uint32_t divisor : test_divisors) {
+    Divider<uint32_t> const reference(divisor);
+    FloatDivider<uint32_t> const divider(divisor);
+    for (DispatchTier tier : {DispatchTier::Scalar, DispatchTier::AVX2, DispatchTier::AVX512}) {
+      if (!force_dispatch_tier(tier)) {
+        continue;
+      }
+      divide(test_dividends.data(), out.data(), test_dividends.size(), divider);
+      remainder(test_dividends.data(), out_rem.data(), test_dividends.size(), divider);
+      for (size_t i = 0; i < test_dividends.size(); ++i) {
+        uint32_t const dividend = test_dividends[i];
+        if (out[i] != reference.divide(dividend) || divider.divide(dividend) != reference.divide(dividend)) {
+          report::mismatch("u32div float divider", dividend, "/", divisor, out[i], reference.divide(dividend));
+        }
+        if (out_rem[i] != reference.remainder(dividend) || divider.remainder(dividend) != reference.remainder(dividend)) {
+          report::mismatch("u32div float divider", dividend, "%", divisor, out_rem[i], reference.remainder(dividend));
+        }
+      }
+    }
+    reset_dispatch_tier();
+  }
+
+  report::finish("u32div float divider");
+}
+
+void test_stats() {
+  using stats::DivPath;
+  std::vector<StatsCase<uint32_t>> const cases = {
+      {100, 1, DivPath::One, false},
+      {100, 10, DivPath::MulShift, false},
+      {100, 7, DivPath::MulAddShift, false},
+      {100, 7, DivPath::MulAddShift, false},
+      {UINT32_MAX, (1U << 31) + 1, DivPath::Large, false}};
+  check_stats<uint32_t>("u32div stats", [](uint32_t dividend, uint32_t divisor) { return opt_cal(dividend, divisor); }, cases);
+}
+
+void test_progression() {
+  // Every base, step and divisor below 2^(T-6), 96 terms each
+  uint32_t const limit = static_cast<uint32_t>(1U << (T - 6));
+  for (uint32_t divisor = 1; divisor < limit; ++divisor) {
+    for (uint32_t base = 0; base < limit; ++base) {
+      for (uint32_t step = 0; step < limit; ++step) {
+        DivisionProgression<uint32_t> progression(base, step, divisor);
+        for (uint32_t i = 0; i < 96; ++i) {
+          uint32_t const value = static_cast<uint32_t>(base + i * step);
+          if (progression.quotient() != normal_cal(value, divisor) || progression.remainder() != normal_rem(value, divisor)) {
+            report::mismatch("u32div progression", value, "/", divisor, progression.quotient(), normal_cal(value, divisor));
+          }
+          ++progression;
+        }
+      }
+    }
+  }
+
+  // Steps above the divisor, divisors above MAX / 2 where r + step % d would
+  // overflow, and progressions that run right up to MAX, through the batch forms
+  std::mt19937_64 rng(2031);
+  uint32_t const max_val = std::numeric_limits<uint32_t>::max();
+  uint32_t const test_divisors[] = {1, 2, 3, 7, 10, 4096, 1000000007, max_val / 2, max_val / 2 + 1, max_val / 2 + 2, max_val - 1, max_val};
+  size_t const n = 1027;
+  std::vector<uint32_t> quotients(n), remainders(n), only_quotients(n);
+  for (uint32_t divisor : test_divisors) {
+    for (int round = 0; round < 64; ++round) {
+      uint32_t const step = static_cast<uint32_t>(rng() >> (rng() % (sizeof(uint32_t) * 8))) / n;
+      uint32_t const room = static_cast<uint32_t>(max_val - step * (n - 1));
+      uint32_t const base = round == 0 ? room : room == max_val ? static_cast<uint32_t>(rng()) : static_cast<uint32_t>(rng() % (static_cast<uint64_t>(room) + 1));
+      DivisionProgression<uint32_t> progression(base, step, divisor);
+      DivisionProgression<uint32_t> quotient_only = progression;
+      progression.divmod(quotients.data(), remainders.data(), n);
+      quotient_only.divide(only_quotients.data(), n);
+      for (size_t i = 0; i < n; ++i) {
+        uint32_t const value = static_cast<uint32_t>(base + i * step);
+        uint32_t const expected = normal_cal(value, divisor);
+        if (quotients[i] != expected || only_quotients[i] != expected) {
+          report::mismatch("u32div progression", value, "/", divisor, quotients[i], expected);
+        }
+        if (remainders[i] != normal_rem(value, divisor)) {
+          report::mismatch("u32div progression", value, "%", divisor, remainders[i], normal_rem(value, divisor));
+        }
+      }
+      // Both batch forms leave the progression on term n
+      uint32_t const next = static_cast<uint32_t>(base + n * step);
+      if (step <= (max_val - base) / n && ((*progression).quotient != normal_cal(next, divisor) || quotient_only.remainder() != normal_rem(next, divisor))) {
+        report::mismatch("u32div progression", next, "/", divisor, (*progression).quotient, normal_cal(next, divisor));
+      }
+    }
+  }
+
+  report::finish("u32div progression");
+}
+
+} // namespace u32div
@@ -0,0 +1,736 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <thread>
+
+#include "tests.h"
+
+// =============================================================================
+// Sharded verification engine
+// =============================================================================
+
+namespace verify {
+
+// The T grid above stops at 2^T x 2^T pairs. This engine walks a whole divisor
+// range instead, checking a fixed set of edge dividends plus sampled ones per
+// divisor, split over all cores. Divisors are addressed by a 64-bit index;
+// signed widths read it as two's complement, so [0, 2^32) covers every int32_t.
+struct VerifyOptions {
+  std::string width = "u32";
+  uint64_t begin = 1;
+  uint64_t end = 1ULL << 32;
+  unsigned samples = 32;  // pseudo-random dividends per divisor, on top of the edge set
+  bool proof = false;     // prove each divisor's magic over all dividends instead of sampling
+  bool random = false;    // hash each index to a pseudo-random divisor, for sampling 64-bit ranges
+  bool generator = false; // compare get_unsigned_magic_fast with get_unsigned_magic instead (unsigned widths)
+  bool fp = false;        // check FloatDivider<T> over all 2^32 dividends instead (32-bit widths)
+  unsigned threads = 0;   // 0: std::thread::hardware_concurrency()
+  unsigned shards = 64;   // independent of threads, so a checkpoint resumes on any machine
+  uint64_t chunk = 4096;  // divisors claimed per cursor step
+  uint64_t max_chunks = 0; // stop after this many chunks in this run, 0 for no limit
+  std::string checkpoint; // resume from and periodically save to this file when set
+};
+
+struct VerifyResult {
+  uint64_t divisors = 0;           // verified in this run
+  uint64_t mismatches = 0;         // including earlier runs resumed from the checkpoint
+  uint64_t first_bad = UINT64_MAX; // lowest failing index
+  bool complete = false;
+};
+
+uint64_t splitmix64(uint64_t &state) {
+  uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// Report label for the checks of one width
+template <typename IntType> constexpr char const *verify_test_name() {
+  return std::is_same<IntType, uint32_t>::value   ? "u32 verify"
+         : std::is_same<IntType, int32_t>::value  ? "i32 verify"
+         : std::is_same<IntType, uint64_t>::value ? "u64 verify"
+                                                  : "i64 verify";
+}
+
+// Checks Divider<T> divide/remainder, DivisibilityTester<T>,
+// and BranchfreeDivider<T> and RoundingDivider<T> for signed widths, against
+// the built-in operators.
+// Every failing check goes to the report; returns the number of failing dividends
+template <typename IntType> uint64_t check_divisor(IntType divisor, unsigned samples) {
+  using UIntType = typename std::make_unsigned<IntType>::type;
+  constexpr unsigned B = sizeof(IntType) * 8;
+  IntType const max_val = std::numeric_limits<IntType>::max();
+  IntType const min_val = std::numeric_limits<IntType>::min();
+
+  Divider<IntType> const divider(divisor);
+  DivisibilityTester<IntType> const tester(divisor);
+  // Unsigned widths have neither; Divider<T> stands in and is skipped below
+  using Branchfree = typename std::conditional<std::is_signed<IntType>::value, BranchfreeDivider<IntType>, Divider<IntType>>::type;
+  using Rounding = typename std::conditional<std::is_signed<IntType>::value, RoundingDivider<IntType>, Divider<IntType>>::type;
+  Branchfree const branchfree(divisor);
+  Rounding const rounding(divisor);
+  char const *const test = verify_test_name<IntType>();
+  uint64_t mismatches = 0;
+  bool failed = false;
+  auto expect = [&](IntType dividend, char const *op, auto result, auto expected) {
+    if (result != expected) {
+      failed = true;
+      report::mismatch(test, dividend, op, divisor, result, expected);
+    }
+  };
+  auto check = [&](IntType dividend) {
+    // MIN / -1 is UB for the built-in operator
+    if (std::is_signed<IntType>::value && dividend == min_val && divisor == static_cast<IntType>(-1)) {
+      return;
+    }
+    IntType const expected_quot = dividend / divisor;
+    IntType const expected_rem = dividend % divisor;
+    failed = false;
+    expect(dividend, "/", divider.divide(dividend), expected_quot);
+    expect(dividend, "%", divider.remainder(dividend), expected_rem);
+    expect(dividend, "divisible by", tester.is_divisible(dividend), expected_rem == 0);
+    if constexpr (std::is_signed<IntType>::value) {
+      expect(dividend, "branchfree /", branchfree.divide(dividend), expected_quot);
+      expect(dividend, "branchfree %", branchfree.remainder(dividend), expected_rem);
+      expect(dividend, "div_floor", rounding.div_floor(dividend), reference_div_floor(dividend, divisor));
+      expect(dividend, "div_ceil", rounding.div_ceil(dividend), reference_div_ceil(dividend, divisor));
+      expect(dividend, "div_euclid", rounding.div_euclid(dividend), reference_div_euclid(dividend, divisor));
+      expect(dividend, "rem_floor", rounding.rem_floor(dividend), reference_rem_floor(dividend, divisor));
+      expect(dividend, "rem_euclid", rounding.rem_euclid(dividend), reference_rem_euclid(dividend, divisor));
+    }
+    mismatches += failed ? 1 : 0;
+  };
+  auto wrap_add = [](IntType x, IntType y) { return static_cast<IntType>(static_cast<UIntType>(x) + static_cast<UIntType>(y)); };
+
+  // The magic's rounding error peaks at the last multiples below the extremes
+  IntType const top = max_val - max_val % divisor;
+  IntType const bottom = divisor == static_cast<IntType>(-1) ? min_val : min_val - min_val % divisor;
+  IntType const edges[] = {0,
+                           1,
+                           static_cast<IntType>(-1),
+                           wrap_add(divisor, -1),
+                           divisor,
+                           wrap_add(divisor, 1),
+                           max_val,
+                           wrap_add(max_val, -1),
+                           top,
+                           wrap_add(top, -1),
+                           min_val,
+                           wrap_add(min_val, 1),
+                           bottom,
+                           wrap_add(bottom, -1)};
+  for (IntType dividend : edges) {
+    check(dividend);
+  }
+
+  uint64_t state = static_cast<uint64_t>(static_cast<UIntType>(divisor));
+  for (unsigned i = 0; i < samples; ++i) {
+    uint64_t const bits = splitmix64(state);
+    // Every other sample is shortened so small quotients are covered too
+    uint64_t const value = (i & 1) == 0 ? bits : bits >> (bits % B);
+    check(static_cast<IntType>(static_cast<UIntType>(value)));
+  }
+  return mismatches;
+}
+
+// Returns 1 if the magic Divider<T> and opt_cal use for divisor fails its proof.
+// Powers of two and |d| <= 1 never go through a magic number.
+template <typename IntType> uint64_t prove_divisor(IntType divisor) {
+  using UIntType = typename std::make_unsigned<IntType>::type;
+  if constexpr (std::is_signed<IntType>::value) {
+    UIntType const ad = divisor < 0 ? 0U - static_cast<UIntType>(divisor) : static_cast<UIntType>(divisor);
+    if ((ad & (ad - 1)) == 0) {
+      return 0;
+    }
+    return prove_signed_magic(divisor, get_signed_magic(divisor)) ? 0 : 1;
+  } else {
+    if ((divisor & (divisor - 1)) == 0) {
+      return 0;
+    }
+    return prove_unsigned_magic(divisor, get_unsigned_magic(divisor)) ? 0 : 1;
+  }
+}
+
+// Returns 1 if the fast magic generator disagrees with the Hacker's Delight loop for divisor
+template <typename IntType> uint64_t compare_magic_generators(IntType divisor) {
+  if constexpr (std::is_signed<IntType>::value) {
+    return 0; // run_cli rejects signed widths
+  } else {
+    if (divisor == 1) {
+      return 0;
+    }
+    auto const slow = get_unsigned_magic(divisor);
+    auto const fast = get_unsigned_magic_fast(divisor);
+    return slow.magic == fast.magic && slow.shift == fast.shift && slow.is_add == fast.is_add ? 0 : 1;
+  }
+}
+
+// Checks FloatDivider<T> batch divide and remainder over every dividend against
+// the Divider<T> dispatch kernels. Returns 1 if any dividend fails.
+template <typename IntType> uint64_t check_float_divisor(IntType divisor) {
+  if constexpr (sizeof(IntType) != 4) {
+    return 0; // run_cli rejects 64-bit widths
+  } else {
+    using UIntType = typename std::make_unsigned<IntType>::type;
+    constexpr size_t kBlock = 4096;
+    Divider<IntType> const divider(divisor);
+    FloatDivider<IntType> const fp_divider(divisor);
+    auto const &kernels = dispatch_kernels<IntType>();
+    auto const &fp_kernels = dispatch_float_kernels<IntType>();
+    std::vector<IntType> in(kBlock), quotients(kBlock), remainders(kBlock), expected_q(kBlock), expected_r(kBlock);
+    uint64_t bad = 0;
+    for (uint64_t base = 0; base < (1ULL << 32); base += kBlock) {
+      for (size_t i = 0; i < kBlock; ++i) {
+        in[i] = static_cast<IntType>(static_cast<UIntType>(base + i));
+      }
+      fp_kernels.divide_batch(in.data(), quotients.data(), kBlock, fp_divider);
+      fp_kernels.remainder_batch(in.data(), remainders.data(), kBlock, fp_divider);
+      kernels.divmod_batch(in.data(), expected_q.data(), expected_r.data(), kBlock, divider);
+      for (size_t i = 0; i < kBlock; ++i) {
+        if (quotients[i] != expected_q[i]) {
+          report::mismatch(verify_test_name<IntType>(), in[i], "/ (float)", divisor, quotients[i], expected_q[i]);
+          bad = 1;
+        }
+        if (remainders[i] != expected_r[i]) {
+          report::mismatch(verify_test_name<IntType>(), in[i], "% (float)", divisor, remainders[i], expected_r[i]);
+          bad = 1;
+        }
+      }
+    }
+    return bad;
+  }
+}
+
+template <typename IntType> IntType divisor_at(uint64_t index, bool random) {
+  using UIntType = typename std::make_unsigned<IntType>::type;
+  if (random) {
+    // Shortened by a random amount so every magnitude is sampled, not just the top bits
+    uint64_t const bits = splitmix64(index);
+    index = static_cast<uint64_t>(static_cast<int64_t>(bits) >> (bits % (sizeof(IntType) * 8)));
+  }
+  return static_cast<IntType>(static_cast<UIntType>(index));
+}
+
+template <typename IntType> uint64_t check_index(uint64_t index, VerifyOptions const &options) {
+  IntType const divisor = divisor_at<IntType>(index, options.random);
+  if (divisor == 0) {
+    return 0;
+  }
+  if (options.generator) {
+    uint64_t const bad = compare_magic_generators(divisor);
+    if (bad != 0) {
+      report::mismatch(verify_test_name<IntType>(), "any", "magic generator", divisor, "fast", "loop");
+    }
+    return bad;
+  }
+  if (options.fp) {
+    return check_float_divisor(divisor);
+  }
+  if (options.proof) {
+    uint64_t const bad = prove_divisor(divisor);
+    if (bad != 0) {
+      report::mismatch(verify_test_name<IntType>(), "any", "magic proof", divisor, "refuted", "proved");
+    }
+    return bad;
+  }
+  return check_divisor(divisor, options.samples);
+}
+
+// Each shard owns a slice of the range and an atomic cursor. Workers start on
+// their own shard and steal from the others once it runs dry. Before claiming
+// a chunk a worker publishes a lower bound of it in its in-flight slot, so a
+// checkpoint taken at any moment never skips past unfinished work.
+class ShardedVerifier {
+public:
+  explicit ShardedVerifier(VerifyOptions const &options)
+      : options_(options), shards_(options.shards == 0 ? 1 : options.shards), cursors_(shards_), ends_(shards_) {
+    uint128 const span = options_.end - options_.begin;
+    for (unsigned s = 0; s < shards_; ++s) {
+      cursors_[s].value = options_.begin + static_cast<uint64_t>(span * s / shards_);
+      ends_[s] = options_.begin + static_cast<uint64_t>(span * (s + 1) / shards_);
+    }
+  }
+
+  // Returns false if the file exists but was written for different options
+  bool load_checkpoint() {
+    if (options_.checkpoint.empty()) {
+      return true;
+    }
+    std::ifstream in(options_.checkpoint);
+    if (!in) {
+      return true;
+    }
+    std::string header;
+    std::getline(in, header);
+    if (header != checkpoint_header()) {
+      return false;
+    }
+    std::string tag;
+    in >> tag >> mismatches_base_ >> tag >> first_bad_base_;
+    for (unsigned s = 0; s < shards_; ++s) {
+      uint64_t cursor = 0;
+      in >> tag >> cursor;
+      cursors_[s].value = cursor;
+    }
+    return static_cast<bool>(in);
+  }
+
+  void save_checkpoint() const {
+    if (options_.checkpoint.empty()) {
+      return;
+    }
+    std::string const tmp = options_.checkpoint + ".tmp";
+    {
+      std::ofstream out(tmp, std::ios::trunc);
+      out << checkpoint_header() << '\n';
+      out << "mismatches " << mismatches_base_ + mismatches_.load() << " first_bad " << std::min(first_bad_base_, first_bad_.load()) << '\n';
+      for (unsigned s = 0; s < shards_; ++s) {
+        out << "shard " << safe_cursor(s) << '\n';
+      }
+    }
+    std::remove(options_.checkpoint.c_str());
+    std::rename(tmp.c_str(), options_.checkpoint.c_str());
+  }
+
+  // check(index) returns the number of mismatches for one divisor index
+  template <typename Check> VerifyResult run(Check check) {
+    unsigned const threads = options_.threads != 0 ? options_.threads : std::max(1U, std::thread::hardware_concurrency());
+    uint64_t const chunk = options_.chunk == 0 ? 1 : options_.chunk;
+    in_flight_ = std::vector<PaddedCounter>(static_cast<size_t>(threads) * shards_);
+    for (auto &slot : in_flight_) {
+      slot.value = kIdle;
+    }
+    budget_ = options_.max_chunks == 0 ? INT64_MAX : static_cast<int64_t>(options_.max_chunks);
+    std::atomic<unsigned> running(threads);
+    report::ProgressCounters divisors(threads);
+
+    auto worker = [&](unsigned w) {
+      unsigned const home = static_cast<unsigned>(static_cast<uint64_t>(w) * shards_ / threads);
+      for (unsigned k = 0; k < shards_; ++k) {
+        unsigned const s = (home + k) % shards_;
+        std::atomic<uint64_t> &slot = in_flight_[static_cast<size_t>(w) * shards_ + s].value;
+        for (;;) {
+          if (budget_.fetch_sub(1) <= 0) {
+            running.fetch_sub(1);
+            return;
+          }
+          uint64_t first = cursors_[s].value.load();
+          slot.store(first);
+          // Compare-exchange rather than fetch_add, so the cursor never runs past the end and wraps near 2^64
+          uint64_t last = first;
+          do {
+            if (first >= ends_[s]) {
+              break;
+            }
+            last = ends_[s] - first > chunk ? first + chunk : ends_[s];
+          } while (!cursors_[s].value.compare_exchange_weak(first, last));
+          if (first >= ends_[s]) {
+            slot.store(kIdle);
+            budget_.fetch_add(1);
+            break;
+          }
+          slot.store(first);
+          for (uint64_t index = first; index < last; ++index) {
+            uint64_t const bad = check(index);
+            if (bad != 0) {
+              mismatches_.fetch_add(bad);
+              uint64_t seen = first_bad_.load();
+              while (index < seen && !first_bad_.compare_exchange_weak(seen, index)) {
+              }
+            }
+          }
+          divisors.add(w, last - first);
+          slot.store(kIdle);
+        }
+      }
+      running.fetch_sub(1);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned w = 0; w < threads; ++w) {
+      pool.emplace_back(worker, w);
+    }
+
+    auto last_save = std::chrono::steady_clock::now();
+    while (running.load() != 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      auto const now = std::chrono::steady_clock::now();
+      if (now - last_save >= std::chrono::seconds(10)) {
+        last_save = now;
+        save_checkpoint();
+        std::cout << "Processing " << options_.width << " verify: " << divisors.total() << " divisors, " << mismatches_.load() << " mismatches"
+                  << std::endl;
+      }
+    }
+    for (auto &thread : pool) {
+      thread.join();
+    }
+    save_checkpoint();
+
+    VerifyResult result;
+    result.divisors = divisors.total();
+    result.mismatches = mismatches_base_ + mismatches_.load();
+    result.first_bad = std::min(first_bad_base_, first_bad_.load());
+    result.complete = true;
+    for (unsigned s = 0; s < shards_; ++s) {
+      result.complete = result.complete && safe_cursor(s) == ends_[s];
+    }
+    return result;
+  }
+
+private:
+  static constexpr uint64_t kIdle = UINT64_MAX;
+
+  struct alignas(64) PaddedCounter {
+    std::atomic<uint64_t> value{0};
+    PaddedCounter() = default;
+    PaddedCounter(PaddedCounter const &other) : value(other.value.load()) {
+    }
+  };
+
+  std::string checkpoint_header() const {
+    return "divtomulti-verify 1 width " + options_.width + " begin " + std::to_string(options_.begin) + " end " + std::to_string(options_.end) +
+           " samples " + std::to_string(options_.samples) + " proof " + std::to_string(options_.proof) + " random " + std::to_string(options_.random) +
+           " generator " + std::to_string(options_.generator) + " float " + std::to_string(options_.fp) + " shards " + std::to_string(shards_);
+  }
+
+  // Everything below this index in shard s has been verified. The cursor is
+  // read before the in-flight slots: a chunk claimed after the cursor read is
+  // still above it, and one claimed before had its lower bound published first.
+  uint64_t safe_cursor(unsigned s) const {
+    uint64_t safe = std::min(cursors_[s].value.load(), ends_[s]);
+    for (size_t w = s; w < in_flight_.size(); w += shards_) {
+      safe = std::min(safe, in_flight_[w].value.load());
+    }
+    return safe;
+  }
+
+  VerifyOptions options_;
+  unsigned shards_;
+  std::vector<PaddedCounter> cursors_;
+  std::vector<uint64_t> ends_;
+  std::vector<PaddedCounter> in_flight_; // [worker * shards + shard]
+  std::atomic<int64_t> budget_{0};
+  std::atomic<uint64_t> mismatches_{0};
+  std::atomic<uint64_t> first_bad_{UINT64_MAX};
+  uint64_t mismatches_base_ = 0;
+  uint64_t first_bad_base_ = UINT64_MAX;
+};
+
+// Runs the Divider<T> checker matching options.width
+VerifyResult verify(ShardedVerifier &verifier, VerifyOptions const &options) {
+  if (options.width == "i32") {
+    return verifier.run([&options](uint64_t index) { return check_index<int32_t>(index, options); });
+  } else if (options.width == "u64") {
+    return verifier.run([&options](uint64_t index) { return check_index<uint64_t>(index, options); });
+  } else if (options.width == "i64") {
+    return verifier.run([&options](uint64_t index) { return check_index<int64_t>(index, options); });
+  }
+  return verifier.run([&options](uint64_t index) { return check_index<uint32_t>(index, options); });
+}
+
+// DivToMulti verify <u32|i32|u64|i64> [--begin N] [--end N] [--samples N] [--proof] [--random] [--generator] [--float]
+//                   [--threads N] [--shards N] [--chunk N] [--max-chunks N] [--checkpoint FILE]
+int run_cli(int argc, char **argv) {
+  VerifyOptions options;
+  if (argc < 1) {
+    std::cout << "Usage: DivToMulti verify <u32|i32|u64|i64> [--begin N] [--end N] [--samples N] [--proof] [--random] [--generator] [--float] [--threads N] "
+                 "[--shards N] [--chunk N] [--max-chunks N] [--checkpoint FILE]"
+              << std::endl;
+    return 2;
+  }
+  options.width = argv[0];
+  if (options.width != "u32" && options.width != "i32" && options.width != "u64" && options.width != "i64") {
+    std::cout << "Error: unknown width " << options.width << std::endl;
+    return 2;
+  }
+  // Signed indices start at 0 so the default range is every two's complement pattern
+  options.begin = options.width[0] == 'i' ? 0 : 1;
+  for (int i = 1; i < argc; ++i) {
+    std::string const flag = argv[i];
+    if (flag == "--proof") {
+      options.proof = true;
+      continue;
+    } else if (flag == "--random") {
+      options.random = true;
+      continue;
+    } else if (flag == "--generator") {
+      options.generator = true;
+      continue;
+    } else if (flag == "--float") {
+      options.fp = true;
+      continue;
+    }
+    if (i + 1 == argc) {
+      std::cout << "Error: missing value for " << flag << std::endl;
+      return 2;
+    }
+    std::string const value = argv[++i];
+    uint64_t const number = std::strtoull(value.c_str(), nullptr, 0);
+    if (flag == "--begin") {
+      options.begin = number;
+    } else if (flag == "--end") {
+      options.end = number;
+    } else if (flag == "--samples") {
+      options.samples = static_cast<unsigned>(number);
+    } else if (flag == "--threads") {
+      options.threads = static_cast<unsigned>(number);
+    } else if (flag == "--shards") {
+      options.shards = static_cast<unsigned>(number);
+    } else if (flag == "--chunk") {
+      options.chunk = number;
+    } else if (flag == "--max-chunks") {
+      options.max_chunks = number;
+    } else if (flag == "--checkpoint") {
+      options.checkpoint = value;
+    } else {
+      std::cout << "Error: unknown option " << flag << std::endl;
+      return 2;
+    }
+  }
+  if (options.generator && (options.proof || options.width[0] == 'i')) {
+    std::cout << "Error: --generator only applies to unsigned widths, without --proof" << std::endl;
+    return 2;
+  }
+  if (options.fp && (options.proof || options.generator || options.width.substr(1) != "32")) {
+    std::cout << "Error: --float only applies to 32-bit widths, without --proof or --generator" << std::endl;
+    return 2;
+  }
+  if (options.end < options.begin) {
+    std::cout << "Error: --end is below --begin" << std::endl;
+    return 2;
+  }
+
+  ShardedVerifier verifier(options);
+  if (!verifier.load_checkpoint()) {
+    std::cout << "Error: checkpoint " << options.checkpoint << " was written with different options" << std::endl;
+    return 2;
+  }
+  VerifyResult const result = verify(verifier, options);
+  std::cout << options.width << " verify: " << result.divisors << " divisors checked, " << result.mismatches << " mismatches"
+            << (result.complete ? "" : " (incomplete, resume from the checkpoint)") << std::endl;
+  if (result.mismatches != 0) {
+    std::cout << "Error: first mismatch at divisor index " << result.first_bad << std::endl;
+    report::summary();
+    return 1;
+  }
+  return 0;
+}
+
+void test_sharded_verifier() {
+  // Every index is visited exactly once across threads and shards
+  VerifyOptions options;
+  options.begin = 3;
+  options.end = 20000;
+  options.threads = 4;
+  options.shards = 7;
+  options.chunk = 64;
+  std::vector<std::atomic<uint8_t>> visits(options.end);
+  VerifyResult result = ShardedVerifier(options).run([&](uint64_t index) {
+    visits[index].fetch_add(1);
+    return index == 777 || index == 12345 ? 1 : 0;
+  });
+  for (uint64_t index = 0; index < options.end; ++index) {
+    if (visits[index].load() != (index >= options.begin ? 1 : 0)) {
+      report::mismatch("sharded verifier", index, "visits in", "run", visits[index].load(), index >= options.begin ? 1 : 0);
+    }
+  }
+  if (!result.complete) {
+    report::mismatch("sharded verifier", "complete", "of", "run", result.complete, true);
+  }
+  if (result.divisors != options.end - options.begin) {
+    report::mismatch("sharded verifier", "divisors", "of", "run", result.divisors, options.end - options.begin);
+  }
+  if (result.mismatches != 2 || result.first_bad != 777) {
+    report::mismatch("sharded verifier", "mismatches, first", "of", "run",
+                     std::to_string(result.mismatches) + ", " + std::to_string(result.first_bad),
+                     "2, 777");
+  }
+
+  // A run stopped by --max-chunks resumes from its checkpoint and covers the rest
+  options.checkpoint = "divtomulti_verify_test.ckpt";
+  options.max_chunks = 40;
+  std::remove(options.checkpoint.c_str());
+  for (auto &visit : visits) {
+    visit.store(0);
+  }
+  uint64_t total = 0;
+  result = VerifyResult();
+  for (int run = 0; run < 100 && !result.complete; ++run) {
+    ShardedVerifier verifier(options);
+    if (!verifier.load_checkpoint()) {
+      report::mismatch("sharded verifier", "checkpoint", "of", "resumed run", "rejected", "loaded");
+      break;
+    }
+    result = verifier.run([&](uint64_t index) {
+      visits[index].fetch_add(1);
+      return index == 777 ? 1 : 0;
+    });
+    total += result.divisors;
+  }
+  std::remove(options.checkpoint.c_str());
+  for (uint64_t index = options.begin; index < options.end; ++index) {
+    if (visits[index].load() == 0) {
+      report::mismatch("sharded verifier", index, "visits in", "resumed run", 0, "at least 1");
+    }
+  }
+  if (!result.complete) {
+    report::mismatch("sharded verifier", "complete", "of", "resumed run", result.complete, true);
+  }
+  if (total < options.end - options.begin) {
+    report::mismatch("sharded verifier", "divisors", "of", "resumed run", total, "at least " + std::to_string(options.end - options.begin));
+  }
+  if (result.first_bad != 777) {
+    report::mismatch("sharded verifier", "first mismatch", "of", "resumed run", result.first_bad, 777);
+  }
+
+  // The real checkers agree with the built-in operators on a slice of each width
+  char const *widths[] = {"u32", "i32", "u64", "i64"};
+  for (char const *width : widths) {
+    VerifyOptions slice;
+    slice.width = width;
+    slice.begin = 0;
+    slice.end = 1 << 16;
+    slice.samples = 8;
+    slice.threads = 2;
+    ShardedVerifier verifier(slice);
+    VerifyResult const checked = verify(verifier, slice);
+    if (checked.mismatches != 0) {
+      report::mismatch("sharded verifier", checked.first_bad, "first bad index in", width, checked.mismatches, 0);
+    }
+  }
+
+  report::finish("sharded verifier");
+}
+
+template <typename IntType> void check_magic_proof(IntType divisor) {
+  using UIntType = typename std::make_unsigned<IntType>::type;
+  bool proved = false;
+  bool off_by_one = false;
+  // One below the generated magic is below 2^k / |d|, which has to be refuted
+  if constexpr (std::is_signed<IntType>::value) {
+    auto dm = get_signed_magic(divisor);
+    proved = prove_signed_magic(divisor, dm);
+    dm.magic = static_cast<IntType>(static_cast<UIntType>(dm.magic) + (divisor > 0 ? static_cast<UIntType>(-1) : 1U));
+    off_by_one = prove_signed_magic(divisor, dm);
+  } else {
+    auto dm = get_unsigned_magic(divisor);
+    proved = prove_unsigned_magic(divisor, dm);
+    if (dm.magic != 0) {
+      dm.magic -= 1;
+      off_by_one = prove_unsigned_magic(divisor, dm);
+    }
+  }
+  if (!proved || off_by_one) {
+    std::cout << "Error: magic proof for divisor " << divisor << ": proved " << proved << ", off by one proved " << off_by_one << std::endl;
+    std::terminate();
+  }
+}
+
+void test_magic_proofs() {
+  // The critical-dividend argument against brute force, at 12 bits where every dividend can be tried
+  std::mt19937_64 rng(2024);
+  constexpr unsigned B = 12;
+  uint64_t const n_max = (1ULL << B) - 1;
+  uint64_t const m_max = 1ULL << (B - 1);
+  for (int i = 0; i < 4000; ++i) {
+    uint64_t const d = 1 + rng() % n_max;
+    unsigned const k = static_cast<unsigned>(rng() % (2 * B + 2));
+    int64_t const near = static_cast<int64_t>(((1ULL << k) + d - 1) / d) + static_cast<int64_t>(rng() % 5) - 2;
+    if (near < 0) {
+      continue;
+    }
+    uint64_t const magic = static_cast<uint64_t>(near);
+
+    bool floor_holds = true;
+    for (uint64_t n = 0; n <= n_max && floor_holds; ++n) {
+      floor_holds = ((n * magic) >> k) == n / d;
+    }
+    bool ceil_holds = true;
+    for (uint64_t m = 1; m <= m_max && ceil_holds; ++m) {
+      // floor(-m * magic / 2^k) == -floor(m / d) - 1
+      ceil_holds = ((m * magic + (1ULL << k) - 1) >> k) == m / d + 1;
+    }
+    if (proves_floor(to_uint256(magic), d, k, n_max) != floor_holds || proves_ceil(to_uint256(magic), d, k, m_max) != ceil_holds) {
+      std::cout << "Error: proof disagrees with brute force for d = " << d << ", k = " << k << ", magic = " << magic << std::endl;
+      std::terminate();
+    }
+  }
+
+  // Every generated magic proves, and the next smaller one does not
+  for (uint64_t divisor = 2; divisor <= (1ULL << T); ++divisor) {
+    if ((divisor & (divisor - 1)) == 0) {
+      continue;
+    }
+    check_magic_proof(static_cast<uint32_t>(divisor));
+    check_magic_proof(static_cast<int32_t>(divisor));
+    check_magic_proof(-static_cast<int32_t>(divisor));
+    check_magic_proof(static_cast<uint64_t>(divisor));
+    check_magic_proof(static_cast<int64_t>(divisor));
+    check_magic_proof(-static_cast<int64_t>(divisor));
+  }
+  uint32_t const u32_divisors[] = {641, 86400, UINT32_MAX, UINT32_MAX - 1, UINT32_MAX / 3, (1U << 31) + 1, (1U << 31) - 1};
+  int32_t const i32_divisors[] = {INT32_MAX, INT32_MAX - 1, INT32_MIN + 1, (1 << 30) + 1, -(1 << 30) - 1, INT32_MAX / 3};
+  uint64_t const u64_divisors[] = {641, 6700417, UINT64_MAX, UINT64_MAX - 1, UINT64_MAX / 3, (1ULL << 63) + 1, (1ULL << 63) - 1, (1ULL << 32) + 1};
+  int64_t const i64_divisors[] = {INT64_MAX, INT64_MAX - 1, INT64_MIN + 1, (1LL << 62) + 1, -(1LL << 62) - 1, INT64_MAX / 3};
+  for (uint32_t divisor : u32_divisors) {
+    check_magic_proof(divisor);
+  }
+  for (int32_t divisor : i32_divisors) {
+    check_magic_proof(divisor);
+  }
+  for (uint64_t divisor : u64_divisors) {
+    check_magic_proof(divisor);
+  }
+  for (int64_t divisor : i64_divisors) {
+    check_magic_proof(divisor);
+  }
+
+  // The engine in proof mode over a slice of each width, contiguous and hashed
+  char const *widths[] = {"u32", "i32", "u64", "i64"};
+  for (char const *width : widths) {
+    for (bool random : {false, true}) {
+      VerifyOptions slice;
+      slice.width = width;
+      slice.begin = 0;
+      slice.end = 1 << 16;
+      slice.proof = true;
+      slice.random = random;
+      slice.threads = 2;
+      ShardedVerifier verifier(slice);
+      VerifyResult const proved = verify(verifier, slice);
+      if (proved.mismatches != 0) {
+        std::cout << "Error: " << width << " magic proof failed at divisor index " << proved.first_bad << std::endl;
+        std::terminate();
+      }
+    }
+  }
+
+  // The fast generator against the loop, over a slice of each unsigned width
+  for (char const *width : {"u32", "u64"}) {
+    for (bool random : {false, true}) {
+      VerifyOptions slice;
+      slice.width = width;
+      slice.begin = 0;
+      slice.end = 1 << 16;
+      slice.generator = true;
+      slice.random = random;
+      slice.threads = 2;
+      ShardedVerifier verifier(slice);
+      VerifyResult const compared = verify(verifier, slice);
+      if (compared.mismatches != 0) {
+        std::cout << "Error: " << width << " fast magic generator differs at divisor index " << compared.first_bad << std::endl;
+        std::terminate();
+      }
+    }
+  }
+
+  std::cout << "magic proof tests passed!" << std::endl;
+}
+
+} // namespace verify
@@ -0,0 +1,270 @@
+#include "tests.h"
+
+namespace u128div {
+
+// std::ostream has no 128-bit overload
+std::string to_string(uint128 value) {
+  std::string digits;
+  do {
+    digits.insert(digits.begin(), static_cast<char>('0' + static_cast<int>(value % 10)));
+    value /= 10;
+  } while (value != 0);
+  return digits;
+}
+
+void test_div() {
+  for (uint64_t i = 0; i <= static_cast<uint64_t>((1ULL << T) - 1); ++i) {
+    report::progress("u128div div", static_cast<uint64_t>(i));
+    // A small dividend and one with a live high word
+    uint128 const dividends[] = {static_cast<uint128>(i), (static_cast<uint128>(i) << 64) | (UINT64_MAX - i)};
+    for (uint128 dividend : dividends) {
+      for (uint64_t divisor = 1; divisor <= static_cast<uint64_t>((1ULL << T) - 1); ++divisor) {
+        uint128 const result = u128div::opt_cal(dividend, divisor);
+        uint128 const expected = u128div::normal_cal(dividend, divisor);
+        if (result != expected) {
+          report::mismatch("u128div div", dividend, "/", divisor, result, expected);
+        }
+      }
+    }
+  }
+
+  report::finish("u128div div");
+}
+
+void test_rem() {
+  for (uint64_t i = 0; i <= static_cast<uint64_t>((1ULL << T) - 1); ++i) {
+    report::progress("u128div rem", static_cast<uint64_t>(i));
+    uint128 const dividends[] = {static_cast<uint128>(i), (static_cast<uint128>(i) << 64) | (UINT64_MAX - i)};
+    for (uint128 dividend : dividends) {
+      for (uint64_t divisor = 1; divisor <= static_cast<uint64_t>((1ULL << T) - 1); ++divisor) {
+        uint64_t const result = u128div::opt_rem(dividend, divisor);
+        uint64_t const expected = u128div::normal_rem(dividend, divisor);
+        if (result != expected) {
+          report::mismatch("u128div rem", dividend, "%", divisor, result, expected);
+        }
+      }
+    }
+  }
+
+  report::finish("u128div rem");
+}
+
+void test_wide_divider() {
+  std::mt19937_64 rng(2024);
+  uint128 const max_128 = ~static_cast<uint128>(0);
+
+  std::vector<uint128> test_dividends = {0, 1, 100, UINT64_MAX, static_cast<uint128>(1) << 64, (static_cast<uint128>(1) << 64) + 1,
+                                         static_cast<uint128>(1) << 127, (static_cast<uint128>(1) << 127) - 1, max_128, max_128 - 1};
+  while (test_dividends.size() < 256) {
+    uint64_t const hi = rng() >> (rng() % 64);
+    test_dividends.push_back((static_cast<uint128>(hi) << 64) | rng());
+  }
+
+  std::vector<uint64_t> test_divisors = {1, 2, 3, 7, 10, 1000000000, 10000000000000000000ULL, 1ULL << 32, (1ULL << 32) + 1, (1ULL << 32) - 1,
+                                         1ULL << 63, (1ULL << 63) + 1, (1ULL << 63) - 1, UINT64_MAX, UINT64_MAX - 1};
+  while (test_divisors.size() < 64) {
+    uint64_t const divisor = rng() >> (rng() % 64);
+    if (divisor != 0) {
+      test_divisors.push_back(divisor);
+    }
+  }
+
+  for (uint64_t divisor : test_divisors) {
+    WideDivider<uint64_t> const divider(divisor);
+    for (uint128 dividend : test_dividends) {
+      uint64_t rem_result = 0;
+      uint128 const result = divider.divide(dividend, rem_result);
+      uint128 const expected = u128div::normal_cal(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("u128div wide divider", dividend, "/", divisor, result, expected);
+      }
+      uint64_t const rem_expected = u128div::normal_rem(dividend, divisor);
+      if (rem_result != rem_expected) {
+        report::mismatch("u128div wide divider", dividend, "% (divide)", divisor, rem_result, rem_expected);
+      }
+      if (divider.remainder(dividend) != rem_expected) {
+        report::mismatch("u128div wide divider", dividend, "%", divisor, divider.remainder(dividend), rem_expected);
+      }
+    }
+  }
+
+  report::finish("u128div wide divider");
+}
+
+// Schoolbook reference: one 128/64 hardware-library division per limb
+uint64_t reference_divide_limbs(std::vector<uint64_t> const &in, std::vector<uint64_t> &out, uint64_t divisor) {
+  uint64_t r = 0;
+  for (size_t i = in.size(); i-- > 0;) {
+    uint128 const part = (static_cast<uint128>(r) << 64) | in[i];
+    out[i] = static_cast<uint64_t>(part / divisor);
+    r = static_cast<uint64_t>(part % divisor);
+  }
+  return r;
+}
+
+void test_limbs() {
+  std::mt19937_64 rng(2025);
+  std::vector<uint64_t> test_divisors = {1, 2, 3, 7, 10, 1000000007, 10000000000000000000ULL, 1ULL << 32, (1ULL << 32) + 1,
+                                         1ULL << 63, (1ULL << 63) + 1, (1ULL << 63) - 1, UINT64_MAX, UINT64_MAX - 1};
+  while (test_divisors.size() < 64) {
+    uint64_t const divisor = rng() >> (rng() % 64);
+    if (divisor != 0) {
+      test_divisors.push_back(divisor);
+    }
+  }
+
+  for (uint64_t divisor : test_divisors) {
+    WideDivider<uint64_t> const divider(divisor);
+    for (size_t n : {0, 1, 2, 3, 4, 5, 8, 9, 64}) {
+      std::vector<uint64_t> in(n);
+      for (size_t i = 0; i < n; ++i) {
+        // All-ones and all-zero limbs, plus random ones
+        uint64_t const kind = rng() % 4;
+        in[i] = kind == 0 ? 0 : kind == 1 ? UINT64_MAX : rng();
+      }
+      std::string const label = std::to_string(n) + " limbs";
+      std::vector<uint64_t> expected(n);
+      uint64_t const expected_rem = reference_divide_limbs(in, expected, divisor);
+
+      std::vector<uint64_t> out(n);
+      uint64_t const rem = divide_limbs(in.data(), out.data(), n, divider);
+      if (out != expected) {
+        report::mismatch("u128div limbs", label.c_str(), "/", divisor, "quotient limbs", "reference");
+      }
+      if (rem != expected_rem) {
+        report::mismatch("u128div limbs", label.c_str(), "%", divisor, rem, expected_rem);
+      }
+      if (remainder_limbs(in.data(), n, divider) != expected_rem) {
+        report::mismatch("u128div limbs", label.c_str(), "% (remainder_limbs)", divisor, remainder_limbs(in.data(), n, divider), expected_rem);
+      }
+
+      // In place, and streamed in two pieces with the top piece first
+      std::vector<uint64_t> inplace = in;
+      if (divide_limbs(inplace.data(), inplace.data(), n, divider) != expected_rem || inplace != expected) {
+        report::mismatch("u128div limbs", label.c_str(), "/ (in place)", divisor, "quotient limbs", "reference");
+      }
+      size_t const split = n / 2;
+      std::vector<uint64_t> streamed(n);
+      uint64_t const carry = divide_limbs(in.data() + split, streamed.data() + split, n - split, divider);
+      if (divide_limbs(in.data(), streamed.data(), split, divider, carry) != expected_rem || streamed != expected) {
+        report::mismatch("u128div limbs", label.c_str(), "/ (streamed)", divisor, "quotient limbs", "reference");
+      }
+      uint64_t const rem_carry = remainder_limbs(in.data() + split, n - split, divider);
+      if (remainder_limbs(in.data(), split, divider, rem_carry) != expected_rem) {
+        report::mismatch("u128div limbs", label.c_str(), "% (streamed)", divisor, remainder_limbs(in.data(), split, divider, rem_carry),
+                         expected_rem);
+      }
+    }
+  }
+
+  report::finish("u128div limbs");
+}
+
+} // namespace u128div
+
+namespace i128div {
+
+std::string to_string(int128 value) {
+  uint128 const magnitude = value < 0 ? 0U - static_cast<uint128>(value) : static_cast<uint128>(value);
+  return value < 0 ? "-" + u128div::to_string(magnitude) : u128div::to_string(magnitude);
+}
+
+// Sign-extended i in the high word, so the quotient's high word is live too
+int128 wide_dividend(int64_t i) {
+  return static_cast<int128>((static_cast<uint128>(static_cast<int128>(i)) << 64) | static_cast<uint64_t>(~i));
+}
+
+void test_div() {
+  int64_t const min_val = -(1LL << (T - 1));
+  int64_t const max_val = (1LL << (T - 1)) - 1;
+
+  for (int64_t i = min_val; i <= max_val; ++i) {
+    report::progress("i128div div", static_cast<uint64_t>(i - min_val));
+    int128 const dividends[] = {static_cast<int128>(i), wide_dividend(i)};
+    for (int128 dividend : dividends) {
+      for (int64_t divisor = min_val; divisor <= max_val; ++divisor) {
+        if (divisor == 0)
+          continue;
+
+        int128 const result = i128div::opt_cal_signed(dividend, divisor);
+        int128 const expected = i128div::normal_cal(dividend, divisor);
+        if (result != expected) {
+          report::mismatch("i128div div", dividend, "/", divisor, result, expected);
+        }
+      }
+    }
+  }
+
+  report::finish("i128div div");
+}
+
+void test_rem() {
+  int64_t const min_val = -(1LL << (T - 1));
+  int64_t const max_val = (1LL << (T - 1)) - 1;
+
+  for (int64_t i = min_val; i <= max_val; ++i) {
+    report::progress("i128div rem", static_cast<uint64_t>(i - min_val));
+    int128 const dividends[] = {static_cast<int128>(i), wide_dividend(i)};
+    for (int128 dividend : dividends) {
+      for (int64_t divisor = min_val; divisor <= max_val; ++divisor) {
+        if (divisor == 0)
+          continue;
+
+        int64_t const result = i128div::opt_rem_signed(dividend, divisor);
+        int64_t const expected = i128div::normal_rem(dividend, divisor);
+        if (result != expected) {
+          report::mismatch("i128div rem", dividend, "%", divisor, result, expected);
+        }
+      }
+    }
+  }
+
+  report::finish("i128div rem");
+}
+
+void test_wide_divider() {
+  std::mt19937_64 rng(2024);
+  int128 const max_128 = static_cast<int128>(~static_cast<uint128>(0) >> 1);
+  int128 const min_128 = -max_128 - 1;
+
+  std::vector<int128> test_dividends = {0, 1, -1, 100, -100, INT64_MAX, INT64_MIN, static_cast<int128>(INT64_MAX) + 1,
+                                        static_cast<int128>(INT64_MIN) - 1, max_128, max_128 - 1, min_128, min_128 + 1};
+  while (test_dividends.size() < 256) {
+    uint64_t const hi = rng() >> (rng() % 64);
+    test_dividends.push_back(static_cast<int128>((static_cast<uint128>(rng() % 2 == 0 ? hi : ~hi) << 64) | rng()));
+  }
+
+  std::vector<int64_t> test_divisors = {1, -1, 2, -2, 3, -3, 7, -7, 10, -10, 1LL << 32, -(1LL << 32), (1LL << 32) + 1, INT64_MAX, INT64_MAX - 1,
+                                        INT64_MIN, INT64_MIN + 1, 1LL << 62, -(1LL << 62)};
+  while (test_divisors.size() < 64) {
+    int64_t const divisor = static_cast<int64_t>(rng()) >> (rng() % 64);
+    if (divisor != 0) {
+      test_divisors.push_back(divisor);
+    }
+  }
+
+  for (int64_t divisor : test_divisors) {
+    WideDivider<int64_t> const divider(divisor);
+    for (int128 dividend : test_dividends) {
+      int64_t rem_result = 0;
+      int128 const result = divider.divide(dividend, rem_result);
+      // MIN / -1 wraps, like opt_cal_signed
+      bool const overflows = dividend == min_128 && divisor == -1;
+      int128 const expected = overflows ? min_128 : i128div::normal_cal(dividend, divisor);
+      if (result != expected) {
+        report::mismatch("i128div wide divider", dividend, "/", divisor, result, expected);
+      }
+      int64_t const rem_expected = overflows ? 0 : i128div::normal_rem(dividend, divisor);
+      if (rem_result != rem_expected) {
+        report::mismatch("i128div wide divider", dividend, "% (divide)", divisor, rem_result, rem_expected);
+      }
+      if (divider.remainder(dividend) != rem_expected) {
+        report::mismatch("i128div wide divider", dividend, "%", divisor, divider.remainder(dividend), rem_expected);
+      }
+    }
+  }
+
+  report::finish("i128div wide divider");
+}
+
+} // namespace i128div